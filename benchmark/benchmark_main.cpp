@@ -5,13 +5,571 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <algorithm>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dom/batch_parser.hpp"
+#include "dom/dom_manager.hpp"
+#include "dom/html_token_parser.hpp"
+#include "dom/main_content.hpp"
+#include "dom/subtree_stats.hpp"
+#include "dom/tree_index.hpp"
+#include "query/query.hpp"
+#include "query/query_set.hpp"
+#include "query/streaming_matcher.hpp"
+#include "string/structural_index.hpp"
+#include "utils/tag.hpp"
+#include "utils/string_pool.hpp"
+
+namespace {
+
+// Builds a crawl-like page of roughly target_size bytes: nested blocks, attributes and prose
+std::string MakeSyntheticPage(std::size_t target_size) {
+  std::string page = "<html><head><title>Synthetic page</title><meta name=\"description\" content=\"A page\">";
+  page += "<meta property=\"og:title\" content=\"Synthetic\"><meta property=\"og:type\" content=\"article\">";
+  page += "</head><body>";
+  std::uint32_t item = 0;
+  while (page.size() < target_size) {
+    page += "<div class=\"item item-" + std::to_string(item % 7) + "\" id=\"n" + std::to_string(item) + "\">";
+    page += "<h2>Heading number " + std::to_string(item) + "</h2>";
+    page += "<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut ";
+    page += "labore et dolore magna aliqua. <a href=\"/articles/" + std::to_string(item) + "\">Read more</a></p>";
+    page += "<ul><li>first</li><li>second</li><li>third</li></ul><br></div>\n";
+    ++item;
+  }
+  page += "</body></html>";
+  return page;
+}
+
+// Like MakeSyntheticPage, but about half of the bytes are inline scripts and styles full of '<', quotes and '='
+std::string MakeScriptHeavyPage(std::size_t target_size) {
+  std::string page = "<html><head><style>.item > a { color: #333; } a[href^='/x'] { content: '<'; }</style></head>";
+  page += "<body>";
+  std::uint32_t item = 0;
+  while (page.size() < target_size) {
+    page += "<script>for (var i = 0; i < items.length; i++) { if (items[i].size <= " + std::to_string(item) +
+            ") { html += '<li class=\"x\">' + items[i].name + '</li>'; } }</script>";
+    page += "<div class=\"item\" id=\"n" + std::to_string(item) + "\"><p>Lorem ipsum dolor sit amet, consectetur ";
+    page += "adipiscing elit. <a href=\"/articles/" + std::to_string(item) + "\">Read more</a></p></div>\n";
+    ++item;
+  }
+  page += "</body></html>";
+  return page;
+}
+
+// Statically bound sink doing the minimum per token
+struct CountingSink {
+  std::size_t tokens = 0;
+
+  bool FeedOpenToken(arboris::HtmlToken&&, const char*) {
+    ++tokens;
+    return true;
+  }
+
+  bool FeedTextToken(arboris::HtmlTextToken&&) {
+    ++tokens;
+    return true;
+  }
+
+  bool FeedCloseToken(arboris::HtmlCloseToken&&, const char*) {
+    ++tokens;
+    return true;
+  }
+};
+
+// Tag names in roughly the proportions of real pages, with some upper-case and unknown names mixed in
+std::vector<std::string_view> MakeTagNameStream() {
+  constexpr std::string_view kNames[] = {"div", "a",  "span",   "p",    "li",     "div",   "img",     "a",
+                                         "td",  "tr", "script", "meta", "link",   "DIV",   "Meta",    "br",
+                                         "ul",  "h2", "section", "svg", "button", "input", "x-widget", "span"};
+  std::vector<std::string_view> names;
+  for (int i = 0; i < 64; ++i) {
+    names.insert(names.end(), std::begin(kNames), std::end(kNames));
+  }
+  return names;
+}
+
+}  // anonymous namespace
+
+void BM_HtmlTokenParserParse(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto string_pool = std::make_shared<arboris::StringPool>(page.size());
+    arboris::HtmlTokenParser parser(page, string_pool);
+    benchmark::DoNotOptimize(parser.Parse());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_HtmlTokenParserParse)->Arg(200 << 10)->Arg(2 << 20);
+
+// Same work as BM_HtmlTokenParserParse with set callbacks, against the same counting done by a static sink
+void BM_HtmlTokenParserCallbacks(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::size_t tokens = 0;
+    auto string_pool = std::make_shared<arboris::StringPool>(page.size());
+    arboris::HtmlTokenParser parser(page, string_pool);
+    parser.set_feed_open_token_callback([&tokens](arboris::HtmlToken&&, const char*) { return ++tokens != 0; });
+    parser.set_feed_text_token_callback([&tokens](arboris::HtmlTextToken&&) { return ++tokens != 0; });
+    parser.set_feed_close_token_callback([&tokens](arboris::HtmlCloseToken&&, const char*) { return ++tokens != 0; });
+    benchmark::DoNotOptimize(parser.Parse());
+    benchmark::DoNotOptimize(tokens);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_HtmlTokenParserCallbacks)->Arg(2 << 20);
+
+void BM_HtmlTokenParserStaticSink(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto string_pool = std::make_shared<arboris::StringPool>(page.size());
+    arboris::BasicHtmlTokenParser<CountingSink> parser(page, string_pool);
+    benchmark::DoNotOptimize(parser.Parse());
+    benchmark::DoNotOptimize(parser.sink().tokens);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_HtmlTokenParserStaticSink)->Arg(2 << 20);
+
+void BM_HtmlTokenParserParseScriptHeavy(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeScriptHeavyPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto string_pool = std::make_shared<arboris::StringPool>(page.size());
+    arboris::HtmlTokenParser parser(page, string_pool);
+    benchmark::DoNotOptimize(parser.Parse());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_HtmlTokenParserParseScriptHeavy)->Arg(2 << 20);
+
+void BM_DOMManagerBuild(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    arboris::DOMManager dom(page);
+    benchmark::DoNotOptimize(dom.IsValid());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_DOMManagerBuild)->Arg(200 << 10)->Arg(2 << 20);
+
+void BM_DOMManagerBuildFlat(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    arboris::DOMManager dom(page, {.build_flat_document = true});
+    benchmark::DoNotOptimize(dom.IsValid());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_DOMManagerBuildFlat)->Arg(2 << 20);
+
+void BM_DOMManagerBuildZeroCopy(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    arboris::DOMManager dom(page, {.zero_copy_text = true});
+    benchmark::DoNotOptimize(dom.IsValid());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_DOMManagerBuildZeroCopy)->Arg(200 << 10)->Arg(2 << 20);
+
+// Same pages fed in 16 KB chunks, as they arrive from a socket
+void BM_DOMManagerFeed(benchmark::State& state) {  // NOLINT(runtime/references)
+  constexpr std::size_t kChunkSize = 16 << 10;
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  const std::string_view content(page);
+  for (auto _ : state) {
+    arboris::DOMManager dom;
+    for (std::size_t offset = 0; offset < content.size(); offset += kChunkSize) {
+      benchmark::DoNotOptimize(dom.Feed(content.substr(offset, kChunkSize)));
+    }
+    benchmark::DoNotOptimize(dom.Finish());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_DOMManagerFeed)->Arg(200 << 10)->Arg(2 << 20);
+
+// A crawl-like batch: 256 pages from 8 KB to 1 MB, most of them small
+std::vector<std::string> MakeCrawlBatch() {
+  std::vector<std::string> pages;
+  for (std::size_t i = 0; i < 256; ++i) {
+    pages.push_back(MakeSyntheticPage(i % 32 == 0 ? 1 << 20 : (8 << 10) + (i % 8) * (16 << 10)));
+  }
+  return pages;
+}
+
+std::int64_t TotalSize(const std::vector<std::string>& pages) {
+  std::int64_t total = 0;
+  for (const std::string& page : pages) {
+    total += static_cast<std::int64_t>(page.size());
+  }
+  return total;
+}
+
+// The batch parsed one fresh DOMManager after another, as callers do without ParseBatch()
+void BM_ParseEachPage(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::vector<std::string> pages = MakeCrawlBatch();
+  for (auto _ : state) {
+    for (const std::string& page : pages) {
+      arboris::DOMManager dom(page);
+      benchmark::DoNotOptimize(dom.dom_indexer().elements().size());
+    }
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * TotalSize(pages));
+}
+
+BENCHMARK(BM_ParseEachPage)->Unit(benchmark::kMillisecond);
+
+void BM_ParseBatch(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::vector<std::string> pages = MakeCrawlBatch();
+  const std::vector<std::string_view> documents(pages.begin(), pages.end());
+  const arboris::BatchParseOptions options = {.threads = static_cast<std::size_t>(state.range(0))};
+  for (auto _ : state) {
+    arboris::ParseBatch(documents, options, [](std::size_t, const arboris::DOMManager& dom) {
+      benchmark::DoNotOptimize(dom.dom_indexer().elements().size());
+    });
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * TotalSize(pages));
+}
+
+BENCHMARK(BM_ParseBatch)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Count the <a> elements of a parsed page by walking the linked tree
+void BM_CountTagLinkedTree(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  const arboris::DOMManager dom(page);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    std::vector<const arboris::TagNode*> pending{dom.root()};
+    while (!pending.empty()) {
+      const arboris::TagNode* node = pending.back();
+      pending.pop_back();
+      count += node->tag() == arboris::Tag::kA ? 1 : 0;
+      for (const arboris::BaseNode* child : node->children()) {
+        if (const auto* tag_node = child->As<arboris::TagNode>()) {
+          pending.push_back(tag_node);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+}
+
+BENCHMARK(BM_CountTagLinkedTree)->Arg(2 << 20);
+
+// The same count as one pass over the tag column
+void BM_CountTagFlatDocument(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  const arboris::DOMManager dom(page, {.build_flat_document = true});
+  for (auto _ : state) {
+    const auto tags = dom.flat_document()->tags();
+    benchmark::DoNotOptimize(std::count(tags.begin(), tags.end(), arboris::Tag::kA));
+  }
+}
+
+BENCHMARK(BM_CountTagFlatDocument)->Arg(2 << 20);
+
+// div.item-3 through the tag and class posting lists
+void BM_DOMIndexerFindByTagAndClass(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  const arboris::DOMManager dom(page);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dom.dom_indexer().FindByTagAndClass(arboris::Tag::kDiv, "item-3"));
+  }
+}
+
+BENCHMARK(BM_DOMIndexerFindByTagAndClass)->Arg(2 << 20);
+
+void BM_QuerySelect(benchmark::State& state, std::string_view selectors) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const auto query = arboris::Query::Compile(selectors);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(query->Select(dom.dom_indexer()));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_QuerySelect, a_href, "a[href]");
+BENCHMARK_CAPTURE(BM_QuerySelect, meta_og, "meta[property^='og:']");
+BENCHMARK_CAPTURE(BM_QuerySelect, class_descendant, "div.item-3 li");
+BENCHMARK_CAPTURE(BM_QuerySelect, child, "ul > li");
+BENCHMARK_CAPTURE(BM_QuerySelect, nested_descendant, "div ul li");
+
+// Same selectors answered by attribute indexes, which also cost parse time
+void BM_QuerySelectAttributeIndexes(benchmark::State& state,  // NOLINT(runtime/references)
+                                    std::string_view selectors) {
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page, {.dom_indexer = {.attributes = {"href"}, .attribute_values = {"property"}}});
+  const auto query = arboris::Query::Compile(selectors);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(query->Select(dom.dom_indexer()));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_QuerySelectAttributeIndexes, a_href, "a[href]");
+BENCHMARK_CAPTURE(BM_QuerySelectAttributeIndexes, meta_og, "meta[property^='og:']");
+
+// A typical per-page extraction rule set, run as independent queries and as one QuerySet
+constexpr std::string_view kExtractionSelectors[] = {
+    "title", "meta[name=description i]", "meta[property^='og:']", "a[href]", "div.item h2", "div.item p a[href]",
+    "div.item ul li", "[data-id]",
+};
+
+void BM_QueryIndependent(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  std::vector<arboris::Query> queries;
+  for (const std::string_view selectors : kExtractionSelectors) {
+    queries.push_back(*arboris::Query::Compile(selectors));
+  }
+  for (auto _ : state) {
+    for (const arboris::Query& query : queries) {
+      benchmark::DoNotOptimize(query.Select(dom.dom_indexer()));
+    }
+  }
+}
+
+BENCHMARK(BM_QueryIndependent);
+
+void BM_QuerySetSelect(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const auto query_set = arboris::QuerySet::Compile(kExtractionSelectors);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(query_set->Select(dom.dom_indexer()));
+  }
+}
+
+BENCHMARK(BM_QuerySetSelect);
+
+// The same extraction queries from several threads against one frozen document. The page is built once,
+// outside the timed threads, and never destroyed.
+void BM_QueryIndependentFrozenThreads(benchmark::State& state) {  // NOLINT(runtime/references)
+  static const arboris::FrozenDocument document = [] {
+    const auto* page = new std::string(MakeSyntheticPage(2 << 20));
+    return (new arboris::DOMManager(*page))->Freeze();
+  }();
+  std::vector<arboris::Query> queries;
+  for (const std::string_view selectors : kExtractionSelectors) {
+    queries.push_back(*arboris::Query::Compile(selectors));
+  }
+  for (auto _ : state) {
+    for (const arboris::Query& query : queries) {
+      benchmark::DoNotOptimize(query.Select(document.dom_indexer()));
+    }
+  }
+}
+
+BENCHMARK(BM_QueryIndependentFrozenThreads)->ThreadRange(1, 8)->UseRealTime();
+
+// Link extraction without a DOM, against parsing into one and querying it
+void BM_StreamingMatcherLinks(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  std::size_t links = 0;
+  for (auto _ : state) {
+    auto matcher = arboris::StreamingMatcher::Compile({"a[href]"}, [&links](const arboris::StreamMatch&) {
+      ++links;
+    });
+    arboris::StreamingMatchParser parser(page, nullptr, std::move(*matcher));
+    benchmark::DoNotOptimize(parser.Parse());
+  }
+  benchmark::DoNotOptimize(links);
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_StreamingMatcherLinks)->Arg(2 << 20);
+
+void BM_DOMQueryLinks(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  const auto query = arboris::Query::Compile("a[href]");
+  for (auto _ : state) {
+    const arboris::DOMManager dom(page, {.zero_copy_text = true});
+    benchmark::DoNotOptimize(query->Select(dom.dom_indexer()));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_DOMQueryLinks)->Arg(2 << 20);
+
+// Visible text of a parsed page into a reused buffer, throughput per byte of the page
+void BM_ExtractText(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const arboris::TextExtractionOptions options{.block_separators = state.range(0) != 0};
+  std::string text;
+  for (auto _ : state) {
+    text.clear();
+    benchmark::DoNotOptimize(dom.ExtractText(*dom.root(), options, &text));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_ExtractText)->Arg(0)->Arg(1);
+
+void BM_TreeIndexBuild(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  for (auto _ : state) {
+    const arboris::TreeIndex tree(*dom.root());
+    benchmark::DoNotOptimize(tree.size());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_TreeIndexBuild);
+
+// Lowest common ancestor of every link and the heading of the next item
+void BM_TreeIndexLowestCommonAncestor(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const arboris::TreeIndex tree(*dom.root());
+  const arboris::PostingList links = dom.dom_indexer().FindByTag(arboris::Tag::kA);
+  const arboris::PostingList headings = dom.dom_indexer().FindByTag(arboris::Tag::kH2);
+  const std::size_t pairs = std::min(links.size(), headings.size()) - 1;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < pairs; ++i) {
+      benchmark::DoNotOptimize(tree.LowestCommonAncestor(*links[i], *headings[i + 1]));
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(pairs));
+}
+
+BENCHMARK(BM_TreeIndexLowestCommonAncestor);
+
+// Text and link text of a subtree by visiting it, for comparison with the prefix sums
+std::pair<std::size_t, std::size_t> CountText(const arboris::BaseNode& node, bool in_link) {
+  const auto* tag_node = node.As<arboris::TagNode>();
+  if (tag_node == nullptr) {
+    return {node.text_content().size(), in_link ? node.text_content().size() : 0};
+  }
+  std::pair<std::size_t, std::size_t> totals{0, 0};
+  for (const arboris::BaseNode* child : tag_node->children()) {
+    const auto [text, link_text] = CountText(*child, in_link || tag_node->tag() == arboris::Tag::kA);
+    totals.first += text;
+    totals.second += link_text;
+  }
+  return totals;
+}
+
+// Link density of every div, the core of main-content scoring
+void BM_LinkDensityTraversal(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const arboris::PostingList divs = dom.dom_indexer().FindByTag(arboris::Tag::kDiv);
+  for (auto _ : state) {
+    for (const arboris::TagNode* div : divs) {
+      benchmark::DoNotOptimize(CountText(*div, false));
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(divs.size()));
+}
+
+BENCHMARK(BM_LinkDensityTraversal);
+
+void BM_LinkDensitySubtreeStats(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page);
+  const arboris::PostingList divs = dom.dom_indexer().FindByTag(arboris::Tag::kDiv);
+  for (auto _ : state) {
+    // Building the prefix sums is part of the cost
+    const arboris::SubtreeStats stats(*dom.root());
+    for (const arboris::TagNode* div : divs) {
+      benchmark::DoNotOptimize(stats.Totals(*div).link_density());
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(divs.size()));
+}
+
+BENCHMARK(BM_LinkDensitySubtreeStats);
+
+void BM_LinkDensitySubtreeStatsFlat(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page, {.build_flat_document = true});
+  const arboris::PostingList divs = dom.dom_indexer().FindByTag(arboris::Tag::kDiv);
+  for (auto _ : state) {
+    const arboris::SubtreeStats stats(*dom.flat_document());
+    for (const arboris::TagNode* div : divs) {
+      benchmark::DoNotOptimize(stats.Totals(*div).link_density());
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(divs.size()));
+}
+
+BENCHMARK(BM_LinkDensitySubtreeStatsFlat);
+
+// Main content of a parsed page, without and with a FlatDocument to build the subtree totals from
+void BM_ExtractMainContent(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(2 << 20);
+  const arboris::DOMManager dom(page, {.build_flat_document = state.range(0) != 0});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(arboris::ExtractMainContent(dom));
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_ExtractMainContent)->Arg(0)->Arg(1);
+
+void BM_StructuralIndexBuild(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::string page = MakeSyntheticPage(static_cast<std::size_t>(state.range(0)));
+  arboris::StructuralIndex index;
+  for (auto _ : state) {
+    index.Build(page);
+    benchmark::DoNotOptimize(index.size());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(page.size()));
+}
+
+BENCHMARK(BM_StructuralIndexBuild)->Arg(200 << 10)->Arg(2 << 20);
+
+void BM_TagFromString(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::vector<std::string_view> names = MakeTagNameStream();
+  for (auto _ : state) {
+    for (std::string_view name : names) {
+      benchmark::DoNotOptimize(arboris::FromString(name));
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(names.size()));
+}
+
+BENCHMARK(BM_TagFromString);
+
+// Baseline: the function-static unordered_map lookup FromString used before the perfect hash (case-sensitive)
+void BM_TagUnorderedMapLookup(benchmark::State& state) {  // NOLINT(runtime/references)
+  const std::vector<std::string_view> names = MakeTagNameStream();
+  const auto lookup = [](std::string_view name) {
+    static const std::unordered_map<std::string_view, arboris::Tag> kTagMap = [] {
+      std::unordered_map<std::string_view, arboris::Tag> map;
+      for (std::size_t i = 1; i < arboris::kTagCount; ++i) {
+        map.emplace(arboris::ToString(static_cast<arboris::Tag>(i)), static_cast<arboris::Tag>(i));
+      }
+      return map;
+    }();
+    auto it = kTagMap.find(name);
+    return it == kTagMap.end() ? arboris::Tag::kUnknown : it->second;
+  };
 
-void BM_Example(benchmark::State& state) {  // NOLINT(runtime/references)
   for (auto _ : state) {
-    // Benchmark code
+    for (std::string_view name : names) {
+      benchmark::DoNotOptimize(lookup(name));
+    }
   }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(names.size()));
 }
 
-BENCHMARK(BM_Example);
+BENCHMARK(BM_TagUnorderedMapLookup);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/attribute_index.hpp"
+
+#include <algorithm>
+
+#include "string/string.hpp"
+#include "utils/assertion.hpp"
+
+namespace arboris {
+
+bool AttributeIndex::ValueLess::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+  const int folded = CompareIgnoreAsciiCase(lhs, rhs);
+  return folded != 0 ? folded < 0 : lhs < rhs;
+}
+
+bool AttributeIndex::ValueLess::operator()(Folded lhs, std::string_view rhs) const noexcept {
+  return CompareIgnoreAsciiCase(lhs.value, rhs) < 0;
+}
+
+bool AttributeIndex::ValueLess::operator()(std::string_view lhs, Folded rhs) const noexcept {
+  return CompareIgnoreAsciiCase(lhs, rhs.value) < 0;
+}
+
+void AttributeIndex::Add(TagNode* node, std::string_view value) {
+  nodes_.push_back(node);
+  if (index_values_) {
+    values_[value].push_back(node);
+  }
+}
+
+std::vector<TagNode*> AttributeIndex::FindValue(std::string_view value, bool ignore_case) const {
+  ARBORIS_ASSERT(index_values_, "values of " << name_ << " are not indexed");
+  const auto [first, last] = ignore_case ? values_.equal_range(Folded{value}) : values_.equal_range(value);
+  return collect(first, last, [](std::string_view) { return true; });
+}
+
+std::vector<TagNode*> AttributeIndex::FindPrefix(std::string_view prefix, bool ignore_case) const {
+  ARBORIS_ASSERT(index_values_, "values of " << name_ << " are not indexed");
+  ARBORIS_ASSERT(!prefix.empty(), "prefix must not be empty");
+  // Values starting with the prefix, in any case, follow it directly in the map
+  const auto first = values_.lower_bound(Folded{prefix});
+  auto last = first;
+  while (last != values_.end() && CompareIgnoreAsciiCase(last->first.substr(0, prefix.size()), prefix) == 0) {
+    ++last;
+  }
+  return collect(first, last, [&](std::string_view candidate) {
+    return ignore_case || candidate.substr(0, prefix.size()) == prefix;
+  });
+}
+
+template <typename Predicate>
+std::vector<TagNode*> AttributeIndex::collect(ValueMap::const_iterator first, ValueMap::const_iterator last,
+                                              Predicate keep) const {
+  std::vector<TagNode*> result;
+  std::size_t runs = 0;
+  for (auto it = first; it != last; ++it) {
+    if (keep(it->first)) {
+      result.insert(result.end(), it->second.begin(), it->second.end());
+      ++runs;
+    }
+  }
+  // Each value's nodes are in document order, but the values interleave
+  if (runs > 1) {
+    std::sort(result.begin(), result.end(), InBefore);
+  }
+  return result;
+}
+
+}  // namespace arboris
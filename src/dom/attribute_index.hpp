@@ -0,0 +1,101 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_ATTRIBUTE_INDEX_HPP_
+#define SRC_DOM_ATTRIBUTE_INDEX_HPP_
+
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dom/tag_node.hpp"
+
+namespace arboris {
+
+// The elements that have one attribute, e.g. every element with an href, and optionally their values.
+// Values are kept in an ordered map, so equality and prefix lookups are range lookups with or without the i flag
+// of CSS attribute selectors.
+class AttributeIndex {
+ public:
+  AttributeIndex(std::string name, bool index_values) : name_(std::move(name)), index_values_(index_values) {}
+
+  /**
+   * @brief Add an element, in document order
+   * @param node Element that has the attribute
+   * @param value Value of the attribute on node, a view into the document
+   */
+  void Add(TagNode* node, std::string_view value);
+
+  // Remove every element, keeping the attribute name
+  void Clear() {
+    nodes_.clear();
+    values_.clear();
+  }
+
+  // Attribute name, as configured
+  [[nodiscard]] const std::string& name() const noexcept {
+    return name_;
+  }
+
+  [[nodiscard]] bool values_indexed() const noexcept {
+    return index_values_;
+  }
+
+  // Elements with the attribute, sorted by in()
+  [[nodiscard]] std::span<TagNode* const> nodes() const noexcept {
+    return nodes_;
+  }
+
+  /**
+   * @brief Find the elements whose attribute equals a value. Requires values_indexed()
+   * @param value Value to look for
+   * @param ignore_case Whether to compare ignoring ASCII case
+   * @return Matching elements, sorted by in()
+   */
+  [[nodiscard]] std::vector<TagNode*> FindValue(std::string_view value, bool ignore_case) const;
+
+  /**
+   * @brief Find the elements whose attribute starts with a prefix. Requires values_indexed()
+   * @param prefix Non-empty prefix to look for
+   * @param ignore_case Whether to compare ignoring ASCII case
+   * @return Matching elements, sorted by in()
+   */
+  [[nodiscard]] std::vector<TagNode*> FindPrefix(std::string_view prefix, bool ignore_case) const;
+
+ private:
+  // A value looked up ignoring ASCII case
+  struct Folded {
+    std::string_view value;
+  };
+
+  // Orders values ignoring ASCII case first and byte by byte second, so that all the spellings of a value are
+  // adjacent and Folded keys find them together
+  struct ValueLess {
+    using is_transparent = void;
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    bool operator()(Folded lhs, std::string_view rhs) const noexcept;
+    bool operator()(std::string_view lhs, Folded rhs) const noexcept;
+  };
+
+  using ValueMap = std::map<std::string_view, std::vector<TagNode*>, ValueLess>;
+
+  // Nodes of the values in [first, last) that pass keep(value), sorted by in()
+  template <typename Predicate>
+  std::vector<TagNode*> collect(ValueMap::const_iterator first, ValueMap::const_iterator last,
+                                Predicate keep) const;
+
+  const std::string name_;
+  const bool index_values_;
+  std::vector<TagNode*> nodes_;
+  ValueMap values_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_ATTRIBUTE_INDEX_HPP_
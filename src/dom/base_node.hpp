@@ -7,13 +7,11 @@
 #ifndef SRC_DOM_BASE_NODE_HPP_
 #define SRC_DOM_BASE_NODE_HPP_
 
+#include <cstddef>
 #include <cstdint>
-#include <memory>
-#include <string>
+#include <iterator>
 #include <string_view>
-#include <unordered_map>
-#include <utility>
-#include <vector>
+#include <type_traits>
 
 #include "utils/assertion.hpp"
 #include "utils/html_tokens.hpp"
@@ -26,17 +24,19 @@ enum class NodeType : std::uint8_t { kTag, kText };
 // forward declaration
 class TagNode;
 
+// Nodes live in the document's Arena and link to each other with raw pointers.
+// They are trivially destructible, so a whole document is freed without visiting its nodes.
 class BaseNode {
  public:
-  explicit BaseNode(NodeType type, std::uint32_t id, std::shared_ptr<TagNode> parent = nullptr)
-      : node_type_(type), node_id_(id), parent_(std::move(parent)) {}
+  explicit BaseNode(NodeType type, std::uint32_t id, TagNode* parent = nullptr)
+      : node_type_(type), node_id_(id), parent_(parent) {}
 
   BaseNode(const BaseNode&) = delete;
   BaseNode& operator=(const BaseNode&) = delete;
   BaseNode(BaseNode&&) = delete;
   BaseNode& operator=(BaseNode&&) = delete;
 
-  virtual ~BaseNode() = default;
+  ~BaseNode() = default;
 
   [[nodiscard]] std::uint32_t node_id() const noexcept {
     return node_id_;
@@ -46,6 +46,15 @@ class BaseNode {
     return node_type_;
   }
 
+  // nullptr for the document root
+  [[nodiscard]] TagNode* parent() const noexcept {
+    return parent_;
+  }
+
+  [[nodiscard]] BaseNode* next_sibling() const noexcept {
+    return next_sibling_;
+  }
+
   [[nodiscard]] std::uint32_t in() const noexcept {
     return in_;
   }
@@ -68,6 +77,10 @@ class BaseNode {
     in_ = in;
   }
 
+  void set_next_sibling(BaseNode* next_sibling) noexcept {
+    next_sibling_ = next_sibling;
+  }
+
   void set_text_content(std::string_view text_content) {
     text_content_ = text_content;
   }
@@ -87,13 +100,68 @@ class BaseNode {
  private:
   const NodeType node_type_;
   const std::uint32_t node_id_;
-  const std::weak_ptr<TagNode> parent_;
+  TagNode* const parent_;
+  BaseNode* next_sibling_{nullptr};
   std::string_view text_content_;
 
   std::uint32_t in_{0};
   std::uint32_t out_{0};
 };
 
+// Forward range over the children of a node, following next_sibling()
+class ChildRange {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BaseNode*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = BaseNode* const*;
+    using reference = BaseNode*;
+
+    Iterator() = default;
+    explicit Iterator(BaseNode* node) : node_(node) {}
+
+    reference operator*() const noexcept {
+      return node_;
+    }
+
+    Iterator& operator++() noexcept {
+      node_ = node_->next_sibling();
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const Iterator& other) const noexcept = default;
+
+   private:
+    BaseNode* node_{nullptr};
+  };
+
+  ChildRange() = default;
+  explicit ChildRange(BaseNode* first_child) : first_child_(first_child) {}
+
+  [[nodiscard]] Iterator begin() const noexcept {
+    return Iterator(first_child_);
+  }
+
+  [[nodiscard]] Iterator end() const noexcept {
+    return {};
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return first_child_ == nullptr;
+  }
+
+ private:
+  BaseNode* first_child_{nullptr};
+};
+
 }  // namespace arboris
 
 #endif  // SRC_DOM_BASE_NODE_HPP_
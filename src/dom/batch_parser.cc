@@ -0,0 +1,154 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/batch_parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <thread>
+
+namespace arboris {
+namespace {
+
+// Documents dealt to one worker: positions [begin, end) of the schedule, largest first. The owner and thieves
+// alike claim the next position with one atomic increment, so taking work never blocks.
+struct alignas(64) WorkQueue {
+  std::atomic<std::size_t> next{0};
+  std::size_t end{0};
+
+  [[nodiscard]] std::size_t remaining() const {
+    const std::size_t claimed = next.load(std::memory_order_relaxed);
+    return claimed < end ? end - claimed : 0;
+  }
+
+  // Claim a position, or return false if the queue ran out
+  bool Pop(std::size_t* position) {
+    if (remaining() == 0) {
+      return false;
+    }
+    *position = next.fetch_add(1, std::memory_order_relaxed);
+    return *position < end;
+  }
+};
+
+class BatchScheduler {
+ public:
+  BatchScheduler(std::span<const std::string_view> documents, std::size_t workers)
+      : documents_(documents), schedule_(documents.size()), queues_(workers) {
+    std::vector<std::size_t> by_size(documents.size());
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::stable_sort(by_size.begin(), by_size.end(), [documents](std::size_t lhs, std::size_t rhs) {
+      return documents[lhs].size() > documents[rhs].size();
+    });
+
+    // Worker w gets the documents ranked w, w + workers, ... in a contiguous slice of the schedule
+    std::size_t position = 0;
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+      queues_[worker].next.store(position, std::memory_order_relaxed);
+      for (std::size_t rank = worker; rank < by_size.size(); rank += workers) {
+        schedule_[position++] = by_size[rank];
+      }
+      queues_[worker].end = position;
+    }
+  }
+
+  // Parse documents until every queue is empty or a callback threw
+  void Run(std::size_t worker, const DOMManagerOptions& options, const BatchParseCallback& on_document) {
+    try {
+      std::optional<DOMManager> manager;
+      std::size_t index = 0;
+      while (take(worker, &index)) {
+        if (manager) {
+          manager->Reset(documents_[index]);
+        } else {
+          manager.emplace(documents_[index], options);
+        }
+        on_document(index, *manager);
+      }
+    } catch (...) {
+      // The first exception is kept for the calling thread; the other workers stop taking documents
+      if (!failed_.exchange(true)) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+
+  // Rethrow the first exception of a worker, once every worker has stopped
+  void RethrowError() const {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  // Next document of the worker, or else the largest remaining one of the worker with the most left
+  bool take(std::size_t worker, std::size_t* index) {
+    if (failed_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::size_t position = 0;
+    if (queues_[worker].Pop(&position)) {
+      *index = schedule_[position];
+      return true;
+    }
+    while (true) {
+      WorkQueue* victim = nullptr;
+      std::size_t most = 0;
+      for (WorkQueue& queue : queues_) {
+        if (const std::size_t remaining = queue.remaining(); remaining > most) {
+          victim = &queue;
+          most = remaining;
+        }
+      }
+      if (victim == nullptr) {
+        return false;
+      }
+      if (victim->Pop(&position)) {
+        *index = schedule_[position];
+        return true;
+      }
+    }
+  }
+
+  const std::span<const std::string_view> documents_;
+  // Document indexes, grouped by worker
+  std::vector<std::size_t> schedule_;
+  std::vector<WorkQueue> queues_;
+
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+};
+
+}  // anonymous namespace
+
+void ParseBatch(std::span<const std::string_view> documents, const BatchParseOptions& options,
+                const BatchParseCallback& on_document) {
+  std::size_t workers = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+  workers = std::min(std::max<std::size_t>(workers, 1), documents.size());
+  if (workers == 0) {
+    return;
+  }
+
+  BatchScheduler scheduler(documents, workers);
+  {
+    // Joined when the block ends, also if starting a thread throws
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+      threads.emplace_back([&scheduler, &options, &on_document, worker] {
+        scheduler.Run(worker, options.document, on_document);
+      });
+    }
+    scheduler.Run(0, options.document, on_document);
+  }
+  scheduler.RethrowError();
+}
+
+}  // namespace arboris
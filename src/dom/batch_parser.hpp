@@ -0,0 +1,78 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_BATCH_PARSER_HPP_
+#define SRC_DOM_BATCH_PARSER_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+
+namespace arboris {
+
+struct BatchParseOptions {
+  // How every document is parsed
+  DOMManagerOptions document;
+
+  // Worker threads, the calling thread included; 0 uses one per hardware thread.
+  // Never more than there are documents.
+  std::size_t threads = 0;
+};
+
+// Called on a worker thread for each parsed document with its index in the batch. The manager is reused for the
+// worker's next document, so nothing of it may be kept after the call; check IsValid() for malformed documents.
+// If a call throws, the workers stop taking documents and ParseBatch() rethrows the first exception once they
+// have all stopped, so some documents may never be called back.
+using BatchParseCallback = std::function<void(std::size_t index, const DOMManager& document)>;
+
+/**
+ * @brief Parse many independent documents on a pool of threads
+ *
+ * Documents are scheduled largest first and dealt round-robin to the workers, which steal the largest remaining
+ * document of the busiest worker once their own run out, so one large page does not end up last on a single
+ * thread. Each worker keeps one DOMManager and reuses it through DOMManager::Reset(), so its arena, string pool,
+ * indexes and tokenizer buffers are allocated for its first, largest document and recycled for the rest.
+ *
+ * @param documents Documents to parse, which must outlive the call
+ * @param options Parsing options and number of threads
+ * @param on_document Called once per document, concurrently from the workers; returns before ParseBatch() does
+ */
+void ParseBatch(std::span<const std::string_view> documents, const BatchParseOptions& options,
+                const BatchParseCallback& on_document);
+
+/**
+ * @brief Parse many independent documents on a pool of threads and extract one result from each
+ *
+ *   const auto titles = ParseBatch(pages, {}, [](std::size_t, const DOMManager& document) {
+ *     return std::string(document.dom_indexer().FindByTag(Tag::kTitle).front()->text_content());
+ *   });
+ *
+ * @param documents Documents to parse, which must outlive the call
+ * @param options Parsing options and number of threads
+ * @param extract Called as extract(index, document) on the worker threads, see BatchParseCallback
+ * @return The result of each document, in the order of documents
+ */
+template <typename Extract, typename Result = std::invoke_result_t<Extract&, std::size_t, const DOMManager&>>
+  requires(!std::is_void_v<Result>)
+[[nodiscard]] std::vector<Result> ParseBatch(std::span<const std::string_view> documents,
+                                             const BatchParseOptions& options, Extract extract) {
+  // Workers write distinct elements at once, which std::vector<bool> packs into shared words
+  static_assert(!std::is_same_v<Result, bool>, "Return a char or an enum instead of bool");
+  std::vector<Result> results(documents.size());
+  ParseBatch(documents, options, [&results, &extract](std::size_t index, const DOMManager& document) {
+    results[index] = extract(index, document);
+  });
+  return results;
+}
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_BATCH_PARSER_HPP_
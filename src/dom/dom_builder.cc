@@ -4,13 +4,15 @@
  *   http://www.apache.org/licenses/LICENSE-2.0
  */
 
-#include <memory>
+#include <span>
+#include <string_view>
 #include <utility>
 
 #include "dom/dom_builder.hpp"
 #include "dom/base_node.hpp"
 #include "dom/tag_node.hpp"
 #include "dom/text_node.hpp"
+#include "string/string.hpp"
 
 namespace arboris {
 
@@ -18,49 +20,84 @@ bool DOMBuilder::Validate() const {
   return node_stack_.empty();
 }
 
+void DOMBuilder::Reset() {
+  next_node_id_ = 1;
+  euler_tour_timer_ = 0;
+  node_stack_ = {};
+  root_ = newRoot();
+}
+
 bool DOMBuilder::FeedOpenToken(HtmlToken&& token, const char* text_begin) {
-  bool is_void_tag = token.is_void_tag;
-  auto parent = node_stack_.empty() ? root_ : node_stack_.top();
-  auto node = std::make_shared<TagNode>(
-    next_node_id_++,
-    std::move(token),
-    parent);
+  return FeedOpenToken(std::move(token), text_begin, [this](TagNode* node) {
+    if (node_creation_callback_) {
+      node_creation_callback_(node);
+    }
+  });
+}
+
+TagNode* DOMBuilder::openNode(HtmlToken&& token, const char* text_begin) {
+  TagNode* parent = node_stack_.empty() ? root_ : node_stack_.top();
+  if (copy_attributes_) {
+    copyAttributes(&token);
+  }
+  const auto attributes = arena_->NewArray(std::span<const HtmlAttribute>(token.attributes));
+  TagNode* node = arena_->New<TagNode>(next_node_id_++, token, attributes, parent);
 
   node->set_in(++euler_tour_timer_);
   node_stack_.push(node);
-  if (parent) {
-    parent->AddChild(node);
-  }
+  parent->AddChild(node);
 
   node->set_text_content({text_begin, 0});  // NOTLINT(bugprone-string-constructor)
-
-
-  if (node_creation_callback_) {
-    node_creation_callback_(node);
+  if (flat_document_) {
+    [[maybe_unused]] const std::uint32_t flat_id =
+        flat_document_->AppendTag(parent->node_id(), token, node->in(), text_begin);
+    ARBORIS_ASSERT(flat_id == node->node_id(), "FlatDocument is out of sync. got " << flat_id);
   }
+  return node;
+}
 
-  if (is_void_tag) {
-    return closeTopNode();
+void DOMBuilder::copyAttributes(HtmlToken* token) {
+  const auto copy = [this](std::string_view text) -> std::string_view {
+    const std::span<char> bytes = arena_->NewArray(std::span<const char>(text));
+    return {bytes.data(), bytes.size()};
+  };
+
+  // Names are unique, so the id and class values are the values of those attributes
+  for (HtmlAttribute& attribute : token->attributes) {
+    attribute.name = copy(attribute.name);
+    attribute.value = copy(attribute.value);
+    if (EqualsIgnoreAsciiCase(attribute.name, "id")) {
+      token->id = attribute.value;
+    } else if (EqualsIgnoreAsciiCase(attribute.name, "class")) {
+      token->classes = ClassList(attribute.value);
+    }
   }
-  return true;
 }
 
 bool DOMBuilder::FeedTextToken(HtmlTextToken&& token) {
-  auto parent = node_stack_.empty() ? root_ : node_stack_.top();
-
-  auto text_node = std::make_shared<TextNode>(
-    next_node_id_++,
-    token.text_content,
-    parent);
+  TagNode* parent = node_stack_.empty() ? root_ : node_stack_.top();
+  TextNode* text_node = arena_->New<TextNode>(next_node_id_++, token.text_content, parent);
+
+  // A text node is a leaf of the Euler tour: it enters and leaves at the same time
+  text_node->set_in(++euler_tour_timer_);
+  text_node->set_out(euler_tour_timer_);
+  if (flat_document_) {
+    [[maybe_unused]] const std::uint32_t flat_id =
+        flat_document_->AppendText(parent->node_id(), token.text_content, text_node->in());
+    ARBORIS_ASSERT(flat_id == text_node->node_id(), "FlatDocument is out of sync. got " << flat_id);
+  }
 
   parent->AddChild(text_node);
   return true;
 }
 
 bool DOMBuilder::FeedCloseToken(HtmlCloseToken&& token, const char* text_end) {
-  ARBORIS_ASSERT(!node_stack_.empty(), "Node stack is empty");
+  // A stray close tag with nothing open makes the document malformed
+  if (node_stack_.empty()) {
+    return false;
+  }
 
-  auto top_node = node_stack_.top();
+  TagNode* top_node = node_stack_.top();
   if (token.tag != top_node->tag()) {
     return false;
   }
@@ -78,9 +115,13 @@ bool DOMBuilder::closeTopNode() {
     return false;
   }
 
-  auto top_node = node_stack_.top();
+  TagNode* top_node = node_stack_.top();
   top_node->set_out(++euler_tour_timer_);
   node_stack_.pop();
+  if (flat_document_) {
+    const std::string_view text = top_node->text_content();
+    flat_document_->CloseTag(top_node->node_id(), top_node->out(), text.data() + text.size());
+  }
   return true;
 }
 
@@ -7,23 +7,30 @@
 #ifndef SRC_DOM_DOM_BUILDER_HPP_
 #define SRC_DOM_DOM_BUILDER_HPP_
 
-#include <memory>
+#include <span>
 #include <stack>
 #include <string>
 #include <functional>
 #include <utility>
 #include <cstdint>
 
+#include "utils/arena.hpp"
 #include "utils/html_tokens.hpp"
+#include "dom/flat_document.hpp"
 #include "dom/tag_node.hpp"
 
 namespace arboris {
 
 class DOMBuilder {
-  using NodeCreationCallback = std::function<void(const std::shared_ptr<TagNode>&)>;
+  using NodeCreationCallback = std::function<void(TagNode*)>;
 
  public:
-  DOMBuilder() : root_(std::make_shared<TagNode>(0, HtmlToken{{0, 0}, Tag::kHtml, false}, nullptr)) {}
+  // Nodes are allocated in arena, which must outlive them. The root has id 0; parsed nodes are numbered from 1.
+  // If flat_document is given, every node is also appended to it under the same id.
+  // With copy_attributes, attribute names and values are copied into the arena too, so the nodes no longer
+  // refer to the source of the tokens; otherwise they stay views into it.
+  explicit DOMBuilder(Arena* arena, FlatDocument* flat_document = nullptr, bool copy_attributes = false)
+      : arena_(arena), flat_document_(flat_document), copy_attributes_(copy_attributes), root_(newRoot()) {}
   DOMBuilder(const DOMBuilder&) = delete;
   DOMBuilder& operator=(const DOMBuilder&) = delete;
   DOMBuilder(DOMBuilder&&) = delete;
@@ -31,23 +38,53 @@ class DOMBuilder {
   virtual ~DOMBuilder() = default;
 
   [[nodiscard]] bool Validate() const;
+
+  // Start another document under a new root. The nodes of the previous one are left to their arena, which is
+  // usually Reset() first, and the flat document, if any, must be cleared by its owner.
+  void Reset();
   bool FeedOpenToken(HtmlToken&& token, const char* text_begin);
+
+  // Statically bound variant for token sinks: on_node_created(node) replaces the node creation callback
+  template <typename NodeCreatedFn>
+  bool FeedOpenToken(HtmlToken&& token, const char* text_begin, NodeCreatedFn&& on_node_created) {
+    const bool is_void_tag = token.is_void_tag;
+    on_node_created(openNode(std::move(token), text_begin));
+    return is_void_tag ? closeTopNode() : true;
+  }
+
   bool FeedTextToken(HtmlTextToken&& token);
   bool FeedCloseToken(HtmlCloseToken&& token, const char* text_end);
 
+  // Parent of the top-level nodes; not part of the parsed content
+  [[nodiscard]] TagNode* root() const noexcept {
+    return root_;
+  }
+
   void SetNodeCreationCallback(NodeCreationCallback&& callback) {
     node_creation_callback_ = std::move(callback);
   }
 
  private:
+  TagNode* newRoot() {
+    return arena_->New<TagNode>(0, HtmlToken{{0, 0}, Tag::kHtml, false}, std::span<const HtmlAttribute>{}, nullptr);
+  }
+
+  // Create a node for the token, attach it to the current parent and push it on the stack
+  TagNode* openNode(HtmlToken&& token, const char* text_begin);
+
+  // Point the attributes, id and classes of the token at copies in the arena
+  void copyAttributes(HtmlToken* token);
   bool closeTopNode();
 
  private:
-  std::uint32_t next_node_id_{0};
+  std::uint32_t next_node_id_{1};
   std::uint32_t euler_tour_timer_{0};
 
-  std::shared_ptr<TagNode> root_;
-  std::stack<std::shared_ptr<TagNode>> node_stack_;
+  Arena* const arena_;
+  FlatDocument* const flat_document_;
+  const bool copy_attributes_;
+  TagNode* root_;
+  std::stack<TagNode*> node_stack_;
 
   NodeCreationCallback node_creation_callback_;
 };
@@ -4,16 +4,122 @@
  *   http://www.apache.org/licenses/LICENSE-2.0
  */
 
-#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 #include "dom/dom_indexer.hpp"
+#include "string/string.hpp"
 
 namespace arboris {
 
-void DOMIndexer::AddNode(const std::shared_ptr<TagNode>& node) {
+std::vector<TagNode*> IntersectPostingLists(PostingList lhs, PostingList rhs) {
+  if (lhs.size() > rhs.size()) {
+    std::swap(lhs, rhs);
+  }
+
+  std::vector<TagNode*> result;
+  // A short list against a long one: binary search each node, narrowing the range as we go
+  constexpr std::size_t kSearchRatio = 16;
+  if (lhs.size() * kSearchRatio < rhs.size()) {
+    auto first = rhs.begin();
+    for (TagNode* node : lhs) {
+      first = std::lower_bound(first, rhs.end(), node, InBefore);
+      if (first == rhs.end()) {
+        break;
+      }
+      if (*first == node) {
+        result.push_back(node);
+      }
+    }
+    return result;
+  }
+
+  std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result), InBefore);
+  return result;
+}
+
+DOMIndexer::DOMIndexer(const DOMIndexerOptions& options) {
+  for (const std::string& name : options.attribute_values) {
+    if (FindAttributeIndex(name) == nullptr) {
+      attribute_indexes_.emplace_back(name, true);
+    }
+  }
+  for (const std::string& name : options.attributes) {
+    if (FindAttributeIndex(name) == nullptr) {
+      attribute_indexes_.emplace_back(name, false);
+    }
+  }
+}
+
+void DOMIndexer::AddNode(TagNode* node) {
+  elements_.emplace_back(node);
   tag_index_[node->tag()].emplace_back(node);
-  // TODO(team): add class index
-  // TODO(team): add id index
+  if (!node->id().empty()) {
+    id_index_[node->id()].emplace_back(node);
+  }
+
+  for (std::string_view class_name : node->classes()) {
+    auto& nodes = class_index_[class_name];
+    // A class repeated in the same attribute is listed once
+    if (nodes.empty() || nodes.back() != node) {
+      nodes.emplace_back(node);
+    }
+  }
+
+  for (AttributeIndex& index : attribute_indexes_) {
+    if (const HtmlAttribute* attribute = node->FindAttribute(index.name())) {
+      index.Add(node, attribute->value);
+    }
+  }
+}
+
+void DOMIndexer::Clear() {
+  elements_.clear();
+  for (auto& [tag, nodes] : tag_index_) {
+    nodes.clear();
+  }
+  // Keys are views into the previous document
+  id_index_.clear();
+  class_index_.clear();
+  for (AttributeIndex& index : attribute_indexes_) {
+    index.Clear();
+  }
+}
+
+PostingList DOMIndexer::FindByTag(Tag tag) const {
+  const auto found = tag_index_.find(tag);
+  return found == tag_index_.end() ? PostingList{} : PostingList(found->second);
+}
+
+TagNode* DOMIndexer::FindById(std::string_view id) const {
+  // The first element with an id wins, as in getElementById()
+  const PostingList nodes = FindAllById(id);
+  return nodes.empty() ? nullptr : nodes.front();
+}
+
+PostingList DOMIndexer::FindAllById(std::string_view id) const {
+  const auto found = id_index_.find(id);
+  return found == id_index_.end() ? PostingList{} : PostingList(found->second);
+}
+
+PostingList DOMIndexer::FindByClass(std::string_view class_name) const {
+  const auto found = class_index_.find(class_name);
+  return found == class_index_.end() ? PostingList{} : PostingList(found->second);
+}
+
+std::vector<TagNode*> DOMIndexer::FindByTagAndClass(Tag tag, std::string_view class_name) const {
+  return IntersectPostingLists(FindByTag(tag), FindByClass(class_name));
+}
+
+const AttributeIndex* DOMIndexer::FindAttributeIndex(std::string_view name) const {
+  for (const AttributeIndex& index : attribute_indexes_) {
+    if (EqualsIgnoreAsciiCase(index.name(), name)) {
+      return &index;
+    }
+  }
+  return nullptr;
 }
 
 }  // namespace arboris
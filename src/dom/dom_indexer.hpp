@@ -7,31 +7,83 @@
 #ifndef SRC_DOM_DOM_INDEXER_HPP_
 #define SRC_DOM_DOM_INDEXER_HPP_
 
-#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "dom/attribute_index.hpp"
 #include "dom/tag_node.hpp"
 
 namespace arboris {
 
+// Sorted by in(), i.e. in document order
+using PostingList = std::span<TagNode* const>;
+
+/**
+ * @brief Intersect two posting lists
+ * @param lhs Nodes sorted by in()
+ * @param rhs Nodes sorted by in()
+ * @return Nodes in both lists, sorted by in()
+ */
+[[nodiscard]] std::vector<TagNode*> IntersectPostingLists(PostingList lhs, PostingList rhs);
+
+// Attribute indexes cost time while parsing and memory for every listed element,
+// so only the attributes named here are indexed. Names ignore ASCII case.
+struct DOMIndexerOptions {
+  // Attributes whose elements are listed, e.g. {"href", "src"}
+  std::vector<std::string> attributes;
+  // Attributes whose elements are listed with their values, for = and ^= lookups, e.g. {"property"}
+  std::vector<std::string> attribute_values;
+};
+
+// Tag, id, class and the configured attribute lookups. Nodes are added in document order, so every posting list
+// is sorted by in(). Keys are views into the document, like the attribute values they come from.
 class DOMIndexer {
  public:
-  DOMIndexer() = default;
+  explicit DOMIndexer(const DOMIndexerOptions& options = {});
   DOMIndexer(const DOMIndexer&) = delete;
   DOMIndexer& operator=(const DOMIndexer&) = delete;
   DOMIndexer(DOMIndexer&&) = delete;
   DOMIndexer& operator=(DOMIndexer&&) = delete;
   virtual ~DOMIndexer() = default;
 
-  void AddNode(const std::shared_ptr<TagNode>& node);
+  void AddNode(TagNode* node);
+
+  // Remove every node, e.g. before indexing another document. Tag lists keep their capacity.
+  void Clear();
+
+  // Elements with the tag
+  [[nodiscard]] PostingList FindByTag(Tag tag) const;
+
+  // Every element, in document order
+  [[nodiscard]] PostingList elements() const noexcept {
+    return elements_;
+  }
+
+  // First element with the id, or nullptr
+  [[nodiscard]] TagNode* FindById(std::string_view id) const;
+
+  // Every element with the id; ids should be unique but documents do not always comply
+  [[nodiscard]] PostingList FindAllById(std::string_view id) const;
+
+  // Elements with the class (case-sensitive)
+  [[nodiscard]] PostingList FindByClass(std::string_view class_name) const;
+
+  // Elements with both the tag and the class, as in a tag.class selector
+  [[nodiscard]] std::vector<TagNode*> FindByTagAndClass(Tag tag, std::string_view class_name) const;
+
+  // Index of an attribute, ignoring ASCII case, or nullptr if the attribute is not indexed
+  [[nodiscard]] const AttributeIndex* FindAttributeIndex(std::string_view name) const;
 
  private:
-  // TODO(team): consider using std::list instead of std::vector for indexes
-  std::unordered_map<std::string, std::shared_ptr<TagNode>> id_index_;
-  std::unordered_map<Tag, std::vector<std::shared_ptr<TagNode>>> tag_index_;
-  std::unordered_map<std::string, std::vector<std::shared_ptr<TagNode>>> class_index_;
+  std::vector<TagNode*> elements_;
+  std::unordered_map<std::string_view, std::vector<TagNode*>> id_index_;
+  std::unordered_map<Tag, std::vector<TagNode*>> tag_index_;
+  std::unordered_map<std::string_view, std::vector<TagNode*>> class_index_;
+  // Few attributes are indexed, so a linear scan finds them faster than hashing a lowercased name
+  std::vector<AttributeIndex> attribute_indexes_;
 };
 
 }  // namespace arboris
@@ -4,38 +4,147 @@
  *   http://www.apache.org/licenses/LICENSE-2.0
  */
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "dom/dom_manager.hpp"
 
 namespace arboris {
 
-DOMManager::DOMManager(std::string_view html_content) {
-  string_pool_ = std::make_shared<StringPool>(html_content.size());
-  dom_builder_ = std::make_unique<DOMBuilder>();
-  dom_indexer_ = std::make_unique<DOMIndexer>();
-  html_token_parser_ = std::make_unique<HtmlTokenParser>(html_content, string_pool_);
+DOMManager::DOMManager(std::string_view html_content, const DOMManagerOptions& options)
+    : html_content_(html_content) {
+  if (!options.zero_copy_text) {
+    string_pool_ = std::make_shared<StringPool>(html_content.size());
+  }
+  if (options.build_flat_document) {
+    flat_document_ = std::make_unique<FlatDocument>();
+    // Typical pages have a node per 16 to 32 bytes of markup
+    flat_document_->Reserve(html_content.size() / 16, html_content.size() / 32);
+  }
+  // Attributes are copied along with the text, so the DOM does not refer to html_content
+  dom_builder_ = std::make_unique<DOMBuilder>(&arena_, flat_document_.get(), !options.zero_copy_text);
+  dom_indexer_ = std::make_unique<DOMIndexer>(options.dom_indexer);
 
   parse();
 }
 
-void DOMManager::parse() {
-  // Set up callbacks for HtmlTokenParser
-  html_token_parser_->set_feed_open_token_callback(
-      std::bind(&DOMBuilder::FeedOpenToken, dom_builder_.get(), std::placeholders::_1, std::placeholders::_2));
+DOMManager::DOMManager(std::shared_ptr<const void> content_owner, std::string_view html_content,
+                       const DOMManagerOptions& options)
+    : DOMManager(html_content, options) {
+  content_owner_ = std::move(content_owner);
+}
 
-  html_token_parser_->set_feed_text_token_callback(
-      std::bind(&DOMBuilder::FeedTextToken, dom_builder_.get(), std::placeholders::_1));
+DOMManager::DOMManager(const DOMManagerOptions& options) {
+  if (options.build_flat_document) {
+    flat_document_ = std::make_unique<FlatDocument>();
+  }
+  dom_builder_ = std::make_unique<DOMBuilder>(&arena_, flat_document_.get());
+  dom_indexer_ = std::make_unique<DOMIndexer>(options.dom_indexer);
 
-  html_token_parser_->set_feed_close_token_callback(
-      std::bind(&DOMBuilder::FeedCloseToken, dom_builder_.get(), std::placeholders::_1, std::placeholders::_2));
+  // Text stays in the stream blocks instead of a pool, whose size is not known up front.
+  // The source of an element may span blocks, so tag nodes get no text.
+  stream_parser_ = std::make_unique<Parser>(std::string_view{}, nullptr,
+                                            BuilderSink{dom_builder_.get(), dom_indexer_.get(), false});
+  parse_succeeded_ = true;
+}
 
-  // Set up node creation callback for DOMBuilder to index nodes
-  dom_builder_->SetNodeCreationCallback(
-      std::bind(&DOMIndexer::AddNode, dom_indexer_.get(), std::placeholders::_1));
+void DOMManager::parse() {
+  Parser html_token_parser(html_content_, string_pool_, BuilderSink{dom_builder_.get(), dom_indexer_.get(), true});
 
   // Start parsing
-  html_token_parser_->Parse();
+  parse_succeeded_ = html_token_parser.Parse();
+}
+
+bool DOMManager::Feed(std::string_view chunk) {
+  return parseChunk(chunk, false);
+}
+
+bool DOMManager::Finish() {
+  return parseChunk({}, true);
+}
+
+bool DOMManager::parseChunk(std::string_view chunk, bool is_last) {
+  // A frozen streamed document has released its parser
+  if (frozen_) {
+    return false;
+  }
+  ARBORIS_ASSERT(stream_parser_, "Feed() and Finish() need a manager constructed for streaming");
+  if (!parse_succeeded_ || stream_finished_) {
+    return false;
+  }
+  stream_finished_ = is_last;
+
+  // The chunk is appended to the last block while it fits, so the parser only indexes the new bytes and resumes
+  // its searches. Otherwise the unconsumed tail moves to a new block with room for at least as much again, so a
+  // token spanning many chunks is copied O(1) times per byte. The old block stays for the views of the DOM.
+  const std::size_t used = stream_content_.size();
+  if (chunk.size() > stream_capacity_ - used) {
+    const std::string_view tail = stream_content_.substr(std::min(stream_parser_->consumed(), used));
+    const std::size_t size = tail.size() + chunk.size();
+    stream_capacity_ = std::max(kMinStreamBlockSize, 2 * size);
+    auto block = std::make_unique_for_overwrite<char[]>(stream_capacity_);
+    std::copy(tail.begin(), tail.end(), block.get());
+    std::copy(chunk.begin(), chunk.end(), block.get() + tail.size());
+
+    // Nothing in a block that was not consumed at all is referenced by the DOM
+    if (!stream_blocks_.empty() && stream_parser_->consumed() == 0) {
+      stream_blocks_.pop_back();
+    }
+    stream_blocks_.push_back(std::move(block));
+    stream_content_ = {stream_blocks_.back().get(), size};
+  } else if (!chunk.empty()) {
+    std::copy(chunk.begin(), chunk.end(), stream_blocks_.back().get() + used);
+    stream_content_ = {stream_content_.data(), used + chunk.size()};
+  }
+
+  parse_succeeded_ = stream_parser_->ParseChunk(stream_content_, is_last);
+  return parse_succeeded_;
+}
+
+bool DOMManager::Reset(std::string_view html_content) {
+  // A frozen document must not change under its views, and streamed documents keep their text in stream blocks
+  if (frozen_ || stream_parser_) {
+    return false;
+  }
+  content_owner_.reset();
+  html_content_ = html_content;
+
+  arena_.Reset();
+  if (string_pool_) {
+    string_pool_->Reset();
+    string_pool_->Reserve(html_content.size());
+  }
+  if (flat_document_) {
+    flat_document_->Clear();
+    flat_document_->Reserve(html_content.size() / 16, html_content.size() / 32);
+  }
+  dom_builder_->Reset();
+  dom_indexer_->Clear();
+
+  if (!parser_) {
+    parser_ = std::make_unique<Parser>(html_content_, string_pool_,
+                                       BuilderSink{dom_builder_.get(), dom_indexer_.get(), true});
+  }
+  parse_succeeded_ = parser_->Parse(html_content_);
+  return parse_succeeded_;
+}
+
+FrozenDocument DOMManager::Freeze() {
+  if (!frozen_ && stream_parser_) {
+    if (!stream_finished_) {
+      parseChunk({}, true);
+    }
+    // Only the blocks are referenced by the DOM; the parser and its buffers are not needed any more
+    stream_parser_.reset();
+  }
+  frozen_ = true;
+  return FrozenDocument(dom_builder_->root(), dom_indexer_.get(), flat_document_.get());
+}
+
+std::size_t DOMManager::ExtractText(const TagNode& subtree, const TextExtractionOptions& options,
+                                    std::string* out) const {
+  return arboris::ExtractText(subtree, options, out);
 }
 
 }  // namespace arboris
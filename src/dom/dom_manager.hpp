@@ -11,35 +11,177 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "dom/dom_builder.hpp"
 #include "dom/dom_indexer.hpp"
+#include "dom/flat_document.hpp"
+#include "dom/frozen_document.hpp"
 #include "dom/html_token_parser.hpp"
+#include "dom/text_extractor.hpp"
+#include "utils/arena.hpp"
 #include "utils/string_pool.hpp"
 
 namespace arboris {
 
+struct DOMManagerOptions {
+  // Also build a FlatDocument while parsing. Whole-document scans get faster, parsing gets slower.
+  bool build_flat_document = false;
+
+  // Leave text and attributes in html_content instead of copying them into a string pool and the arena. Text
+  // nodes and attributes are then views into html_content, which must outlive the manager, and text_content() of
+  // a tag node is its source between the open and close tags, markup included, rather than the concatenated text
+  // of its descendants.
+  bool zero_copy_text = false;
+
+  // Attributes to index for lookups and queries
+  DOMIndexerOptions dom_indexer;
+};
+
 class DOMManager {
  public:
-  explicit DOMManager(std::string_view html_content);
+  // The DOM keeps no reference to html_content unless options.zero_copy_text is set.
+  explicit DOMManager(std::string_view html_content, const DOMManagerOptions& options = {});
+
+  // Keeps content_owner, e.g. a std::shared_ptr<std::string> or the handle of a memory-mapped file holding
+  // html_content, alive as long as the manager, so the DOM can refer to html_content without copies.
+  DOMManager(std::shared_ptr<const void> content_owner, std::string_view html_content,
+             const DOMManagerOptions& options = {});
+
+  // Streaming mode: pass the document with Feed() as it arrives, then call Finish().
+  // The manager keeps the bytes the DOM refers to, so chunks may be released after each call.
+  // Text nodes are views into those bytes; text_content() of tag nodes is empty in this mode.
+  explicit DOMManager(const DOMManagerOptions& options = {});
+
   DOMManager(const DOMManager&) = delete;
   DOMManager& operator=(const DOMManager&) = delete;
   DOMManager(DOMManager&&) = delete;
   DOMManager& operator=(DOMManager&&) = delete;
   virtual ~DOMManager() = default;
 
+  /**
+   * @brief Parse the next piece of a streamed document. Complete tokens are added to the DOM right away
+   * @param chunk Next bytes of the document, copied by the call
+   * @return false if the document is malformed or already finished
+   */
+  bool Feed(std::string_view chunk);
+
+  /**
+   * @brief Parse the rest of a streamed document
+   * @return false if the document is malformed or already finished
+   */
+  bool Finish();
+
+  /**
+   * @brief Seal the document and get a read-only view of it that many threads may query at once,
+   *        see FrozenDocument for the guarantees. A streamed document that is not finished is finished first.
+   *        Later calls return the same view.
+   * @return View of the document, valid as long as the manager
+   */
+  FrozenDocument Freeze();
+
+  /**
+   * @brief Replace the document with another one, reusing the memory of this manager: arena and string pool
+   *        blocks, index and flat document capacity, and the tokenizer's buffers, which a reset manager keeps.
+   *        Every node, view and FrozenDocument of the previous document becomes invalid.
+   * @param html_content Next document, which must outlive the manager's use of it with options.zero_copy_text
+   * @return false if the document is malformed, like IsValid(), or if the manager is frozen or was constructed for
+   *         streaming, which leaves the current document untouched
+   */
+  bool Reset(std::string_view html_content);
+
+  // Whether Freeze() was called; Feed(), Finish() and Reset() then fail
+  [[nodiscard]] bool frozen() const noexcept {
+    return frozen_;
+  }
+
+  // Parent of the top-level nodes of the document
+  [[nodiscard]] const TagNode* root() const noexcept {
+    return dom_builder_->root();
+  }
+
+  // Tag, id and class lookups over the DOM
+  [[nodiscard]] const DOMIndexer& dom_indexer() const noexcept {
+    return *dom_indexer_;
+  }
+
+  // The same nodes as dense columns indexed by node id, or nullptr unless options.build_flat_document was set
+  [[nodiscard]] const FlatDocument* flat_document() const noexcept {
+    return flat_document_.get();
+  }
+
+  // Memory held by the nodes of the document
+  [[nodiscard]] const Arena& arena() const noexcept {
+    return arena_;
+  }
+
+  /**
+   * @brief Append the visible text of a subtree, see arboris::ExtractText()
+   * @param subtree Element of this document whose text is extracted, e.g. *root()
+   * @param options Whitespace handling, separators and excluded tags
+   * @param out Buffer to append to. Reusing it across calls avoids allocating.
+   * @return Number of bytes appended
+   */
+  std::size_t ExtractText(const TagNode& subtree, const TextExtractionOptions& options, std::string* out) const;
+
   bool IsValid() const {
     ARBORIS_ASSERT(dom_builder_, "DOMBuilder is null");
-    return dom_builder_->Validate();
+    return parse_succeeded_ && dom_builder_->Validate();
   }
 
  private:
+  // Binds the tokenizer to the builder and the builder to the indexer at compile time,
+  // so no token goes through a type-erased call on its way into the tree.
+  struct BuilderSink {
+    DOMBuilder* dom_builder;
+    DOMIndexer* dom_indexer;
+    // Whether the text cursors of the tokenizer delimit one contiguous range per element
+    bool text_ranges;
+
+    bool FeedOpenToken(HtmlToken&& token, const char* text_begin) {
+      return dom_builder->FeedOpenToken(std::move(token), text_ranges ? text_begin : nullptr,
+                                        [this](TagNode* node) { dom_indexer->AddNode(node); });
+    }
+
+    bool FeedTextToken(HtmlTextToken&& token) {
+      return dom_builder->FeedTextToken(std::move(token));
+    }
+
+    bool FeedCloseToken(HtmlCloseToken&& token, const char* text_end) {
+      return dom_builder->FeedCloseToken(std::move(token), text_ranges ? text_end : nullptr);
+    }
+  };
+
+  using Parser = BasicHtmlTokenParser<BuilderSink>;
+
   void parse();
+  bool parseChunk(std::string_view chunk, bool is_last);
 
+  // Tokenizer kept across Reset() calls
+  std::unique_ptr<Parser> parser_;
+
+  // Keeps the source of a document parsed without copies alive
+  std::shared_ptr<const void> content_owner_;
+
+  // Owns every node; declared early so that it is destroyed late, releasing the nodes without visiting them
+  Arena arena_;
+  std::unique_ptr<FlatDocument> flat_document_;
   std::unique_ptr<DOMBuilder> dom_builder_;
   std::unique_ptr<DOMIndexer> dom_indexer_;
-  std::unique_ptr<HtmlTokenParser> html_token_parser_;
   std::shared_ptr<StringPool> string_pool_;
+  std::string_view html_content_;
+  bool parse_succeeded_{false};
+  bool frozen_{false};
+
+  // Streaming state. Each block starts with the unconsumed tail of the previous block and is filled with chunks
+  // until the next one does not fit; blocks are never moved, so the views in the DOM stay valid.
+  static constexpr std::size_t kMinStreamBlockSize = 64 * 1024;
+  std::unique_ptr<Parser> stream_parser_;
+  std::vector<std::unique_ptr<char[]>> stream_blocks_;
+  // Filled part of the last block, which the parser is tokenizing, and the size of the block
+  std::string_view stream_content_;
+  std::size_t stream_capacity_{0};
+  bool stream_finished_{false};
 };
 
 }  // namespace arboris
@@ -0,0 +1,107 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/flat_document.hpp"
+
+#include "utils/assertion.hpp"
+
+namespace arboris {
+
+FlatDocument::FlatDocument() {
+  appendNode(kNoNode, NodeType::kTag, Tag::kHtml, 0);
+}
+
+void FlatDocument::Reserve(std::size_t node_count, std::size_t attribute_count) {
+  node_types_.reserve(node_count);
+  tags_.reserve(node_count);
+  ins_.reserve(node_count);
+  outs_.reserve(node_count);
+  parents_.reserve(node_count);
+  first_children_.reserve(node_count);
+  next_siblings_.reserve(node_count);
+  subtree_ends_.reserve(node_count);
+  text_begins_.reserve(node_count);
+  text_ends_.reserve(node_count);
+  attribute_begins_.reserve(node_count);
+  attribute_ends_.reserve(node_count);
+  last_children_.reserve(node_count);
+  attributes_.reserve(attribute_count);
+}
+
+void FlatDocument::Clear() {
+  node_types_.clear();
+  tags_.clear();
+  ins_.clear();
+  outs_.clear();
+  parents_.clear();
+  first_children_.clear();
+  next_siblings_.clear();
+  subtree_ends_.clear();
+  text_begins_.clear();
+  text_ends_.clear();
+  attribute_begins_.clear();
+  attribute_ends_.clear();
+  last_children_.clear();
+  attributes_.clear();
+  appendNode(kNoNode, NodeType::kTag, Tag::kHtml, 0);
+}
+
+std::uint32_t FlatDocument::AppendTag(std::uint32_t parent, const HtmlToken& token, std::uint32_t in,
+                                      const char* text_begin) {
+  const std::uint32_t id = appendNode(parent, NodeType::kTag, token.tag, in);
+  attribute_begins_.back() = static_cast<std::uint32_t>(attributes_.size());
+  attributes_.insert(attributes_.end(), token.attributes.begin(), token.attributes.end());
+  attribute_ends_.back() = static_cast<std::uint32_t>(attributes_.size());
+  text_begins_.back() = text_begin;
+  text_ends_.back() = text_begin;
+  return id;
+}
+
+std::uint32_t FlatDocument::AppendText(std::uint32_t parent, std::string_view text, std::uint32_t in) {
+  const std::uint32_t id = appendNode(parent, NodeType::kText, Tag::kUnknown, in);
+  outs_.back() = in;
+  subtree_ends_.back() = id + 1;
+  text_begins_.back() = text.data();
+  text_ends_.back() = text.data() + text.size();
+  return id;
+}
+
+void FlatDocument::CloseTag(std::uint32_t id, std::uint32_t out, const char* text_end) {
+  ARBORIS_ASSERT(id < size() && node_types_[id] == NodeType::kTag, "id must be a tag node. got " << id);
+  outs_[id] = out;
+  subtree_ends_[id] = size();
+  text_ends_[id] = text_end;
+}
+
+std::uint32_t FlatDocument::appendNode(std::uint32_t parent, NodeType type, Tag tag, std::uint32_t in) {
+  const auto id = size();
+  if (parent != kNoNode) {
+    ARBORIS_ASSERT(parent < id && node_types_[parent] == NodeType::kTag, "parent must be a tag node. got " << parent);
+    if (last_children_[parent] == kNoNode) {
+      first_children_[parent] = id;
+    } else {
+      next_siblings_[last_children_[parent]] = id;
+    }
+    last_children_[parent] = id;
+  }
+
+  node_types_.push_back(type);
+  tags_.push_back(tag);
+  ins_.push_back(in);
+  outs_.push_back(0);
+  parents_.push_back(parent);
+  first_children_.push_back(kNoNode);
+  next_siblings_.push_back(kNoNode);
+  last_children_.push_back(kNoNode);
+  subtree_ends_.push_back(kNoNode);
+  text_begins_.push_back(nullptr);
+  text_ends_.push_back(nullptr);
+  attribute_begins_.push_back(0);
+  attribute_ends_.push_back(0);
+  return id;
+}
+
+}  // namespace arboris
@@ -0,0 +1,178 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_FLAT_DOCUMENT_HPP_
+#define SRC_DOM_FLAT_DOCUMENT_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "dom/base_node.hpp"
+#include "utils/html_tokens.hpp"
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+// Struct-of-arrays copy of the DOM. Every column is indexed by node id, and ids are assigned in preorder,
+// so the subtree of a node is the id range [id, subtree_end(id)) and whole-document scans are linear passes
+// over dense arrays:
+//
+//   const auto tags = document.tags();
+//   const auto images = std::count(tags.begin(), tags.end(), Tag::kImg);
+//
+// Row 0 is the document root. Text nodes have Tag::kUnknown and no attributes.
+class FlatDocument {
+ public:
+  static constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+  FlatDocument();
+  FlatDocument(const FlatDocument&) = delete;
+  FlatDocument& operator=(const FlatDocument&) = delete;
+  FlatDocument(FlatDocument&&) = delete;
+  FlatDocument& operator=(FlatDocument&&) = delete;
+  ~FlatDocument() = default;
+
+  // Number of nodes, including the root
+  [[nodiscard]] std::uint32_t size() const noexcept {
+    return static_cast<std::uint32_t>(tags_.size());
+  }
+
+  [[nodiscard]] NodeType node_type(std::uint32_t id) const {
+    return node_types_[id];
+  }
+
+  [[nodiscard]] Tag tag(std::uint32_t id) const {
+    return tags_[id];
+  }
+
+  // Euler tour timestamps; a text node has in == out. out is 0 for a tag that is never closed.
+  [[nodiscard]] std::uint32_t in(std::uint32_t id) const {
+    return ins_[id];
+  }
+
+  [[nodiscard]] std::uint32_t out(std::uint32_t id) const {
+    return outs_[id];
+  }
+
+  // Links are kNoNode when there is no such node
+  [[nodiscard]] std::uint32_t parent(std::uint32_t id) const {
+    return parents_[id];
+  }
+
+  [[nodiscard]] std::uint32_t first_child(std::uint32_t id) const {
+    return first_children_[id];
+  }
+
+  [[nodiscard]] std::uint32_t next_sibling(std::uint32_t id) const {
+    return next_siblings_[id];
+  }
+
+  // One past the last id in the subtree of id. Tags that are never closed, and the root, extend to the end.
+  [[nodiscard]] std::uint32_t subtree_end(std::uint32_t id) const {
+    return subtree_ends_[id] == kNoNode ? size() : subtree_ends_[id];
+  }
+
+  // Content of a text node, or the source of everything between a tag's open and close tokens
+  [[nodiscard]] std::string_view text(std::uint32_t id) const {
+    return {text_begins_[id], text_ends_[id]};
+  }
+
+  [[nodiscard]] std::span<const HtmlAttribute> attributes(std::uint32_t id) const {
+    return std::span<const HtmlAttribute>(attributes_).subspan(attribute_begins_[id],
+                                                               attribute_ends_[id] - attribute_begins_[id]);
+  }
+
+  /**
+   * @brief Find an attribute of a node by name, ignoring ASCII case
+   * @param id Node id
+   * @param name Attribute name to look for
+   * @return Pointer to the attribute, or nullptr if the node has none with that name
+   */
+  [[nodiscard]] const HtmlAttribute* FindAttribute(std::uint32_t id, std::string_view name) const {
+    return arboris::FindAttribute(attributes(id), name);
+  }
+
+  // Whole columns, indexed by node id
+  [[nodiscard]] std::span<const NodeType> node_types() const noexcept {
+    return node_types_;
+  }
+
+  [[nodiscard]] std::span<const Tag> tags() const noexcept {
+    return tags_;
+  }
+
+  [[nodiscard]] std::span<const std::uint32_t> ins() const noexcept {
+    return ins_;
+  }
+
+  [[nodiscard]] std::span<const std::uint32_t> outs() const noexcept {
+    return outs_;
+  }
+
+  [[nodiscard]] std::span<const std::uint32_t> parents() const noexcept {
+    return parents_;
+  }
+
+  // Make room for node_count nodes and attribute_count attributes in total
+  void Reserve(std::size_t node_count, std::size_t attribute_count);
+
+  // Remove every node but the root, keeping the capacity of the columns
+  void Clear();
+
+  /**
+   * @brief Append a tag node as the last child of parent
+   * @param parent Id of an open tag node
+   * @param token Open token of the node; its attributes are copied
+   * @param in Euler tour timestamp of the open token
+   * @param text_begin Start of the source after the open token
+   * @return Id of the new node
+   */
+  std::uint32_t AppendTag(std::uint32_t parent, const HtmlToken& token, std::uint32_t in, const char* text_begin);
+
+  /**
+   * @brief Append a text node as the last child of parent
+   * @param parent Id of an open tag node
+   * @param text Content of the node
+   * @param in Euler tour timestamp of the node
+   * @return Id of the new node
+   */
+  std::uint32_t AppendText(std::uint32_t parent, std::string_view text, std::uint32_t in);
+
+  /**
+   * @brief Close the subtree of a tag node after its last descendant was appended
+   * @param id Tag node id
+   * @param out Euler tour timestamp of the close token
+   * @param text_end End of the source before the close token
+   */
+  void CloseTag(std::uint32_t id, std::uint32_t out, const char* text_end);
+
+ private:
+  std::uint32_t appendNode(std::uint32_t parent, NodeType type, Tag tag, std::uint32_t in);
+
+  std::vector<NodeType> node_types_;
+  std::vector<Tag> tags_;
+  std::vector<std::uint32_t> ins_;
+  std::vector<std::uint32_t> outs_;
+  std::vector<std::uint32_t> parents_;
+  std::vector<std::uint32_t> first_children_;
+  std::vector<std::uint32_t> next_siblings_;
+  std::vector<std::uint32_t> subtree_ends_;
+  std::vector<const char*> text_begins_;
+  std::vector<const char*> text_ends_;
+  std::vector<std::uint32_t> attribute_begins_;
+  std::vector<std::uint32_t> attribute_ends_;
+  std::vector<HtmlAttribute> attributes_;
+
+  // Only needed while appending: the child to link a new sibling to
+  std::vector<std::uint32_t> last_children_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_FLAT_DOCUMENT_HPP_
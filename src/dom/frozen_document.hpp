@@ -0,0 +1,102 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_FROZEN_DOCUMENT_HPP_
+#define SRC_DOM_FROZEN_DOCUMENT_HPP_
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/flat_document.hpp"
+#include "dom/tag_node.hpp"
+#include "dom/text_extractor.hpp"
+
+namespace arboris {
+
+class DOMManager;
+
+// Elements in document order, which cannot be modified through the list
+using ConstPostingList = std::span<const TagNode* const>;
+
+// Read-only view of a document sealed with DOMManager::Freeze(), for serving queries from many threads:
+//
+//   const FrozenDocument document = manager.Freeze();
+//   std::vector<std::thread> threads;
+//   for (const Query& query : queries) {
+//     threads.emplace_back([document, &query] { Consume(query.Select(document.dom_indexer())); });
+//   }
+//
+// Guarantees, for as long as the manager is alive:
+// - The manager writes nothing reachable from the view again: Feed(), Finish() and Reset() fail.
+// - Nodes, attributes and text never move, so pointers and views taken from the view stay valid.
+// - Reads take no locks and touch no reference counts or lazily filled caches. Any number of threads may call
+//   the view, the const methods of the nodes, the indexer, the flat document and the query classes at once,
+//   once the view reached them through a synchronizing operation such as starting the thread or locking a mutex.
+//
+// Callers must keep their side of the contract: the node API is not const-correct, so posting lists of
+// dom_indexer(), Query results and the links between nodes hand out non-const nodes. Their mutators
+// (AddChild(), set_out(), set_text_content(), ...) belong to DOMBuilder and must not be called on a frozen
+// document; nothing stops a caller that does.
+// The view is three pointers and is meant to be copied into each thread.
+class FrozenDocument {
+ public:
+  // Parent of the top-level nodes of the document
+  [[nodiscard]] const TagNode* root() const noexcept {
+    return root_;
+  }
+
+  // Tag, id, class and attribute lookups, also the input of Query and QuerySet
+  [[nodiscard]] const DOMIndexer& dom_indexer() const noexcept {
+    return *dom_indexer_;
+  }
+
+  // Dense columns of the document, or nullptr unless it was parsed with build_flat_document
+  [[nodiscard]] const FlatDocument* flat_document() const noexcept {
+    return flat_document_;
+  }
+
+  // Elements with the tag, as const nodes
+  [[nodiscard]] ConstPostingList FindByTag(Tag tag) const {
+    return dom_indexer_->FindByTag(tag);
+  }
+
+  // First element with the id, or nullptr
+  [[nodiscard]] const TagNode* FindById(std::string_view id) const {
+    return dom_indexer_->FindById(id);
+  }
+
+  // Elements with the class (case-sensitive)
+  [[nodiscard]] ConstPostingList FindByClass(std::string_view class_name) const {
+    return dom_indexer_->FindByClass(class_name);
+  }
+
+  /**
+   * @brief Append the visible text of a subtree, see arboris::ExtractText()
+   * @param subtree Element of this document whose text is extracted, e.g. *root()
+   * @param options Whitespace handling, separators and excluded tags
+   * @param out Buffer to append to, owned by the calling thread
+   * @return Number of bytes appended
+   */
+  std::size_t ExtractText(const TagNode& subtree, const TextExtractionOptions& options, std::string* out) const {
+    return arboris::ExtractText(subtree, options, out);
+  }
+
+ private:
+  friend class DOMManager;
+
+  FrozenDocument(const TagNode* root, const DOMIndexer* dom_indexer, const FlatDocument* flat_document)
+      : root_(root), dom_indexer_(dom_indexer), flat_document_(flat_document) {}
+
+  const TagNode* root_;
+  const DOMIndexer* dom_indexer_;
+  const FlatDocument* flat_document_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_FROZEN_DOCUMENT_HPP_
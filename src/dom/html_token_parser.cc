@@ -6,6 +6,7 @@
 
 #include "dom/html_token_parser.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdint>
 #include <string>
@@ -13,31 +14,62 @@
 #include <utility>
 
 #include "string/string.hpp"
-#include "utils/string_pool.hpp"
 
 namespace arboris {
+namespace {
+
+// Elements whose content is text up to the matching end tag: raw text (script, style) and RCDATA (textarea, title)
+constexpr std::string_view RawTextEndTag(Tag tag) {
+  switch (tag) {
+    case Tag::kScript:
+      return "</script";
+    case Tag::kStyle:
+      return "</style";
+    case Tag::kTextarea:
+      return "</textarea";
+    case Tag::kTitle:
+      return "</title";
+    default:
+      return {};
+  }
+}
 
-bool HtmlTokenParser::Parse() const {
-  std::size_t pos = 0;
-
-  while (pos < content_.length() && pos != std::string::npos) {
-    if (content_[pos] != '<') {
-      pos = parseTextContent(pos);
-      continue;
-    }
+}  // anonymous namespace
 
-    if (pos + 1 < content_.length() && content_[pos + 1] == '/') {
-      pos = parseCloseTag(pos);
-      continue;
-    }
+void HtmlTokenScanner::buildStructuralIndex() {
+  structural_index_.Build(content_);
+  structural_cursor_ = 0;
+  suspended_begin_ = std::string::npos;
+  bytes_scanned_ += content_.length();
+}
 
-    pos = parseOpenTag(pos);
+void HtmlTokenScanner::beginChunk(std::string_view chunk) {
+  if (chunk.data() == content_.data() && chunk.length() >= content_.length()) {
+    // Grown in place: positions stay the same and only the new bytes are indexed
+    const std::size_t indexed = content_.length();
+    content_ = chunk;
+    structural_index_.Extend(content_, indexed);
+    bytes_scanned_ += content_.length() - indexed;
+  } else {
+    position_offset_ += pos_;
+    content_ = chunk;
+    pos_ = 0;
+    structural_index_.Build(content_);
+    bytes_scanned_ += content_.length();
   }
 
-  return pos != std::string::npos;
+  // The pending token is scanned again from its start
+  structural_cursor_ = 0;
+  skipStructuralsBefore(pos_);
 }
 
-std::size_t HtmlTokenParser::parseOpenTag(std::size_t begin) const {
+void HtmlTokenScanner::beginDocument(std::string_view content) {
+  position_offset_ = 0;
+  content_ = content;
+  pos_ = 0;
+}
+
+std::size_t HtmlTokenScanner::scanOpenTag(std::size_t begin, HtmlToken* token) {
   std::size_t current_pos = begin;
   ++current_pos;  // Skip '<'
 
@@ -47,26 +79,20 @@ std::size_t HtmlTokenParser::parseOpenTag(std::size_t begin) const {
     return std::string::npos;
   }
 
-  Tag tag = FromString(tag_name);
+  token->tag = FromString(tag_name);
+  token->is_void_tag = IsVoidTag(token->tag);
 
-  // Find and skip '>'
-  if (!skipToTagEnd(&current_pos)) {
+  // Parse attributes up to and including '>'
+  if (!parseAttributes(&current_pos, token)) {
     return std::string::npos;
   }
 
-  // Create HtmlToken and call callback
-  HtmlToken token{{static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(current_pos)}, tag, IsVoidTag(tag)};
-
-  if (feed_open_token_callback_) {
-    if (!feed_open_token_callback_(std::move(token), string_pool_->GetCursor())) {
-      return std::string::npos;
-    }
-  }
-
+  token->begin_pos = globalPosition(begin);
+  token->end_pos = globalPosition(current_pos);
   return current_pos;
 }
 
-std::size_t HtmlTokenParser::parseCloseTag(std::size_t begin) const {
+std::size_t HtmlTokenScanner::scanCloseTag(std::size_t begin, HtmlCloseToken* token) {
   std::size_t current_pos = begin;
 
   current_pos += 2;  // Skip '</'
@@ -77,61 +103,177 @@ std::size_t HtmlTokenParser::parseCloseTag(std::size_t begin) const {
     return std::string::npos;
   }
 
-  Tag tag = FromString(tag_name);
-
   // Find and skip '>'
   if (!skipToTagEnd(&current_pos)) {
     return std::string::npos;
   }
 
-  // Create HtmlCloseToken and call callback
-  HtmlCloseToken token{{static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(current_pos)}, tag};
+  token->begin_pos = globalPosition(begin);
+  token->end_pos = globalPosition(current_pos);
+  token->tag = FromString(tag_name);
+  return current_pos;
+}
+
+std::size_t HtmlTokenScanner::scanText(std::size_t begin) {
+  // Read text until '<' or end of string
+  const std::size_t end = nextStructural(begin, '<');
+  return end == std::string::npos ? content_.length() : end;
+}
+
+std::size_t HtmlTokenScanner::scanRawText(std::size_t begin, Tag tag) {
+  const std::string_view end_tag = RawTextEndTag(tag);
+  if (end_tag.empty()) {
+    return begin;
+  }
+
+  // Markup is not recognized inside the element; only "</name" followed by whitespace, '/' or '>' ends it.
+  // Without an end tag the text runs to the end of the content, and a longer content is searched from there.
+  std::size_t from = resumePosition(begin, end_tag.front());
+  std::size_t end = begin;
+  while (true) {
+    end = findIgnoreAsciiCase(from, end_tag);
+    if (end == std::string::npos) {
+      reached_end_ = true;
+      end = content_.length();
+      // The end tag may start in the last bytes and end in the next chunk
+      suspendSearch(begin, end_tag.front(), std::max(from, end - std::min(end, end_tag.length() - 1)));
+      break;
+    }
 
-  if (feed_close_token_callback_) {
-    if (!feed_close_token_callback_(std::move(token), string_pool_->GetCursor())) {
-      return std::string::npos;
+    const std::size_t after = end + end_tag.length();
+    reached_end_ = after == content_.length();
+    if (reached_end_) {
+      suspendSearch(begin, end_tag.front(), end);
+      break;
+    }
+    if (std::isspace(static_cast<unsigned char>(content_[after])) || content_[after] == '/' ||
+        content_[after] == '>') {
+      break;
     }
+    from = end + 1;
   }
 
-  return current_pos;
+  // Structurals inside the text are never visited
+  skipStructuralsBefore(end);
+  return end;
 }
 
-std::size_t HtmlTokenParser::parseTextContent(std::size_t begin) const {
-  std::size_t current_pos = begin;
+std::size_t HtmlTokenScanner::scanMarkup(std::size_t begin, HtmlMarkupToken* token) {
+  constexpr std::string_view kCommentOpen = "<!--";
+  constexpr std::string_view kCdataOpen = "<![CDATA[";
+  constexpr std::string_view kDoctype = "doctype";
 
-  // Read text until '<' or end of string
-  current_pos = FindNextChar(content_, current_pos, '<');
-  if (current_pos == std::string::npos) {
-    current_pos = content_.length();
+  token->begin_pos = globalPosition(begin);
+
+  const std::string_view rest = content_.substr(begin);
+  if (rest.starts_with(kCommentOpen)) {
+    token->kind = HtmlMarkupKind::kComment;
+    return scanDelimitedMarkup(begin + kCommentOpen.length(), "-->", token);
+  }
+  if (rest.starts_with(kCdataOpen)) {
+    token->kind = HtmlMarkupKind::kCdata;
+    return scanDelimitedMarkup(begin + kCdataOpen.length(), "]]>", token);
   }
 
-  if (current_pos == begin) {
-    return current_pos;
+  // Doctypes, processing instructions and bogus comments end at the first '>'
+  std::size_t body_begin = begin + 2;
+  token->kind = HtmlMarkupKind::kComment;
+  if (content_[begin + 1] == '?') {
+    token->kind = HtmlMarkupKind::kProcessingInstruction;
+  } else if (EqualsIgnoreAsciiCase(ExtractSubstring(content_, body_begin, body_begin + kDoctype.length()), kDoctype)) {
+    token->kind = HtmlMarkupKind::kDoctype;
+    body_begin = SkipWhitespace(content_, body_begin + kDoctype.length());
   }
 
-  // Extract text content
-  std::string_view text_content = ExtractSubstring(content_, begin, current_pos);
-  auto pooled_text = string_pool_->Append(text_content);
+  const std::size_t body_end = nextStructural(body_begin, '>');
+  if (body_end == std::string::npos) {
+    return std::string::npos;
+  }
 
-  // Create HtmlTextToken and call callback
-  HtmlTextToken token{{static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(current_pos)}, pooled_text};
+  token->content = ExtractSubstring(content_, body_begin, body_end);
+  if (token->kind == HtmlMarkupKind::kProcessingInstruction && token->content.ends_with('?')) {
+    token->content.remove_suffix(1);
+  }
+  token->end_pos = globalPosition(body_end + 1);
+  return body_end + 1;
+}
 
-  if (feed_text_token_callback_) {
-    if (!feed_text_token_callback_(std::move(token))) {
-      return std::string::npos;
+std::size_t HtmlTokenScanner::scanDelimitedMarkup(std::size_t body_begin, std::string_view terminator,
+                                                  HtmlMarkupToken* token) {
+  // A comment may close right after its opening ("<!-->" or "<!--->"), overlapping the terminator
+  std::size_t body_end = std::string::npos;
+  if (token->kind == HtmlMarkupKind::kComment) {
+    const std::string_view rest = content_.substr(body_begin);
+    if (rest.starts_with('>')) {
+      body_end = body_begin - 2;
+    } else if (rest.starts_with("->")) {
+      body_end = body_begin - 1;
+    }
+  }
+  if (body_end == std::string::npos) {
+    const std::size_t from = resumePosition(body_begin, terminator.front());
+    body_end = findIgnoreAsciiCase(from, terminator);
+    if (body_end == std::string::npos) {
+      const std::size_t length = content_.length();
+      suspendSearch(body_begin, terminator.front(), std::max(from, length - std::min(length, terminator.length() - 1)));
     }
   }
 
-  return current_pos;
+  // Without a terminator the body runs to the end of the content
+  std::size_t end = content_.length();
+  if (body_end == std::string::npos) {
+    reached_end_ = true;
+    body_end = content_.length();
+  } else {
+    end = body_end + terminator.length();
+  }
+
+  // Structurals inside the body are never visited
+  skipStructuralsBefore(end);
+
+  token->content = ExtractSubstring(content_, body_begin, body_end);
+  token->end_pos = globalPosition(end);
+  return end;
+}
+
+std::size_t HtmlTokenScanner::findIgnoreAsciiCase(std::size_t begin, std::string_view needle) {
+  const std::size_t found = FindIgnoreAsciiCase(content_, begin, needle);
+  const std::size_t end = found == std::string::npos ? content_.length() : found + needle.length();
+  bytes_scanned_ += end > begin ? end - begin : 0;
+  return found;
+}
+
+std::size_t HtmlTokenScanner::resumePosition(std::size_t begin, char target) const {
+  if (suspended_begin_ == position_offset_ + begin && suspended_target_ == target) {
+    return suspended_resume_ - position_offset_;
+  }
+  return begin;
 }
 
-std::string_view HtmlTokenParser::extractTagName(std::size_t* begin, std::string_view delimiters) const {
+void HtmlTokenScanner::suspendSearch(std::size_t begin, char target, std::size_t resume) {
+  suspended_begin_ = position_offset_ + begin;
+  suspended_target_ = target;
+  suspended_resume_ = position_offset_ + resume;
+}
+
+HtmlTextToken HtmlTokenScanner::makeTextToken(std::size_t begin, std::size_t end) {
+  // Extract text content
+  std::string_view text_content = ExtractSubstring(content_, begin, end);
+  if (string_pool_) {
+    text_content = string_pool_->Append(text_content);
+  }
+
+  return HtmlTextToken{{globalPosition(begin), globalPosition(end)}, text_content};
+}
+
+std::string_view HtmlTokenScanner::extractTagName(std::size_t* begin, std::string_view delimiters) {
   // Find start of tag name
   *begin = SkipWhitespace(content_, *begin);
   std::size_t tag_name_start = *begin;
 
   // Find end of tag name (until specified delimiters)
   *begin = FindNextAnyChar(content_, *begin, delimiters);
+  reached_end_ = *begin == std::string::npos;
 
   if (*begin == tag_name_start) {
     return std::string_view{};
@@ -141,9 +283,9 @@ std::string_view HtmlTokenParser::extractTagName(std::size_t* begin, std::string
   return result;
 }
 
-bool HtmlTokenParser::skipToTagEnd(std::size_t* begin) const {
+bool HtmlTokenScanner::skipToTagEnd(std::size_t* begin) {
   // Find '>'
-  std::size_t found_pos = SkipUntilChar(content_, *begin, '>');
+  std::size_t found_pos = nextStructural(*begin, '>');
   if (found_pos == std::string::npos) {
     return false;
   }
@@ -152,4 +294,116 @@ bool HtmlTokenParser::skipToTagEnd(std::size_t* begin) const {
   return true;
 }
 
+bool HtmlTokenScanner::parseAttributes(std::size_t* begin, HtmlToken* token) {
+  std::size_t pos = *begin;
+
+  while (true) {
+    pos = SkipWhitespace(content_, pos);
+    if (pos >= content_.length()) {
+      reached_end_ = true;
+      return false;
+    }
+
+    // End of tag; a '/' before it (or anywhere between attributes) is ignored
+    if (content_[pos] == '>') {
+      *begin = pos + 1;
+      return true;
+    }
+    if (content_[pos] == '/') {
+      ++pos;
+      continue;
+    }
+
+    // Attribute name. A leading '=' belongs to the name, as in the HTML tokenizer.
+    const std::size_t name_begin = pos;
+    pos = FindNextAnyChar(content_, pos + 1, kAttributeNameDelimiters);
+    if (pos == std::string::npos) {
+      reached_end_ = true;
+      return false;
+    }
+    const std::string_view name = ExtractSubstring(content_, name_begin, pos);
+
+    // Optional value
+    std::string_view value;
+    pos = SkipWhitespace(content_, pos);
+    if (pos < content_.length() && content_[pos] == '=') {
+      pos = SkipWhitespace(content_, pos + 1);
+      if (pos >= content_.length()) {
+        reached_end_ = true;
+        return false;
+      }
+
+      const char quote = content_[pos];
+      if (quote == '"' || quote == '\'') {
+        // Quotes are structural, so the closing one is the next indexed quote of the same kind
+        const std::size_t value_end = nextStructural(pos + 1, quote);
+        if (value_end == std::string::npos) {
+          return false;
+        }
+        value = content_.substr(pos + 1, value_end - pos - 1);
+        pos = value_end + 1;
+      } else if (quote != '>') {
+        const std::size_t value_begin = pos;
+        pos = FindNextAnyChar(content_, pos, kUnquotedValueDelimiters);
+        if (pos == std::string::npos) {
+          reached_end_ = true;
+          return false;
+        }
+        value = ExtractSubstring(content_, value_begin, pos);
+      }
+    }
+
+    addAttribute(token, name, value);
+  }
+}
+
+void HtmlTokenScanner::addAttribute(HtmlToken* token, std::string_view name, std::string_view value) {
+  // Duplicates are dropped, keeping the first occurrence
+  if (token->FindAttribute(name) != nullptr) {
+    return;
+  }
+
+  token->attributes.push_back({name, value});
+  if (EqualsIgnoreAsciiCase(name, "id")) {
+    token->id = value;
+  } else if (EqualsIgnoreAsciiCase(name, "class")) {
+    token->classes = ClassList(value);
+  }
+}
+
+void HtmlTokenScanner::skipStructuralsBefore(std::size_t pos) {
+  const auto* first = structural_index_.begin() + structural_cursor_;
+  const auto* found = std::lower_bound(first, structural_index_.end(), pos);
+  structural_cursor_ = static_cast<std::size_t>(found - structural_index_.begin());
+}
+
+std::size_t HtmlTokenScanner::nextStructural(std::size_t begin, char target_char) {
+  // A search that ran into the end of the previous content continues with the new positions
+  const std::size_t from = resumePosition(begin, target_char);
+  if (from != begin) {
+    skipStructuralsBefore(from);
+  }
+
+  const std::size_t first = structural_cursor_;
+  const std::size_t count = structural_index_.size();
+  while (structural_cursor_ < count && structural_index_[structural_cursor_] < from) {
+    ++structural_cursor_;
+  }
+
+  for (std::size_t i = structural_cursor_; i < count; ++i) {
+    const std::uint32_t pos = structural_index_[i];
+    if (content_[pos] == target_char) {
+      structural_cursor_ = i;
+      bytes_scanned_ += i + 1 - first;
+      return pos;
+    }
+  }
+  bytes_scanned_ += count - first;
+  suspendSearch(begin, target_char, content_.length());
+  reached_end_ = true;
+  return std::string::npos;
+}
+
+template class BasicHtmlTokenParser<HtmlCallbackSink>;
+
 }  // namespace arboris
@@ -7,66 +7,367 @@
 #ifndef SRC_DOM_HTML_TOKEN_PARSER_HPP_
 #define SRC_DOM_HTML_TOKEN_PARSER_HPP_
 
+#include <concepts>
+#include <cstdint>
 #include <memory>
 #include <functional>
+#include <string>
 #include <string_view>
 #include <utility>
 
 #include "dom/token_parser.hpp"
+#include "string/structural_index.hpp"
 #include "utils/html_tokens.hpp"
+#include "utils/string_pool.hpp"
 
 namespace arboris {
 
-// Forward declaration
-class StringPool;
+// Receiver of the tokens produced by BasicHtmlTokenParser. Every Feed* call returns false to abort the parse.
+// The pointers passed with open and close tokens delimit the text of an element: the text copied into the string
+// pool in between or, without a pool, the source between the two tokens.
+template <typename Sink>
+concept HtmlTokenSink = requires(Sink& sink, HtmlToken&& open_token, HtmlTextToken&& text_token,
+                                 HtmlCloseToken&& close_token, const char* text_cursor) {
+  { sink.FeedOpenToken(std::move(open_token), text_cursor) } -> std::convertible_to<bool>;
+  { sink.FeedTextToken(std::move(text_token)) } -> std::convertible_to<bool>;
+  { sink.FeedCloseToken(std::move(close_token), text_cursor) } -> std::convertible_to<bool>;
+};
 
-class HtmlTokenParser : public TokenParser {
- public:
-  using FeedOpenTokenCallback = std::function<bool(HtmlToken&&, const char*)>;
-  using FeedTextTokenCallback = std::function<bool(HtmlTextToken&&)>;
-  using FeedCloseTokenCallback = std::function<bool(HtmlCloseToken&&, const char*)>;
+// Optional part of a sink. Sinks without it skip comments, doctypes, CDATA sections and processing instructions.
+template <typename Sink>
+concept HtmlMarkupTokenSink = requires(Sink& sink, HtmlMarkupToken&& markup_token) {
+  { sink.FeedMarkupToken(std::move(markup_token)) } -> std::convertible_to<bool>;
+};
 
-  explicit HtmlTokenParser(std::string_view content, std::shared_ptr<StringPool> string_pool)
+// Tokenizer state and scanning steps shared by every BasicHtmlTokenParser instantiation and by TokenCursor.
+// Each scan* step reads one token starting at begin and returns the position after it, or npos on malformed input.
+// Without a string pool, text tokens are views into the content.
+class HtmlTokenScanner : public TokenParser {
+ public:
+  HtmlTokenScanner(std::string_view content, std::shared_ptr<StringPool> string_pool)
       : TokenParser(content), string_pool_(std::move(string_pool)) {}
 
-  HtmlTokenParser(const HtmlTokenParser&) = delete;
-  HtmlTokenParser& operator=(const HtmlTokenParser&) = delete;
-  HtmlTokenParser(HtmlTokenParser&&) = delete;
-  HtmlTokenParser& operator=(HtmlTokenParser&&) = delete;
-
-  ~HtmlTokenParser() override = default;
+  ~HtmlTokenScanner() override = default;
 
-  [[nodiscard]] bool Parse() const override;
+  // Number of bytes of the current content that have been tokenized
+  [[nodiscard]] std::size_t consumed() const noexcept {
+    return pos_;
+  }
 
-  void set_feed_open_token_callback(FeedOpenTokenCallback&& callback) {
-    feed_open_token_callback_ = std::move(callback);
+  // Bytes read so far by the structural index and by the searches for end tags and comment and CDATA terminators,
+  // counting each structural position visited as one byte. It stays linear in the document size however the
+  // document is split into chunks.
+  [[nodiscard]] std::size_t bytes_scanned() const noexcept {
+    return bytes_scanned_;
   }
 
-  void set_feed_text_token_callback(FeedTextTokenCallback&& callback) {
-    feed_text_token_callback_ = std::move(callback);
+ protected:
+  // Outcome of one tokenization step
+  enum class StepResult : std::uint8_t {
+    kToken,       // a token was read (and passed on, if it was not skipped)
+    kIncomplete,  // the token may continue past the end of the content; nothing was read
+    kError,       // malformed input, or the token was rejected
+  };
+
+  // Stage 1: locate every structural character of the content in one vectorized pass
+  void buildStructuralIndex();
+
+  // Continue with more of the document, either the current content grown in place or, at another address, its
+  // unconsumed bytes followed by new ones. Only the bytes not indexed yet are indexed, and a token cut off by the
+  // end of the current content is scanned again from its start, skipping what its searches already ruled out.
+  void beginChunk(std::string_view chunk);
+
+  // Start over with another document
+  void beginDocument(std::string_view content);
+
+  // Position in the whole document of a position in the current content
+  [[nodiscard]] std::uint32_t globalPosition(std::size_t pos) const {
+    return static_cast<std::uint32_t>(position_offset_ + pos);
   }
 
-  void set_feed_close_token_callback(FeedCloseTokenCallback&& callback) {
-    feed_close_token_callback_ = std::move(callback);
+  [[nodiscard]] std::size_t scanOpenTag(std::size_t begin, HtmlToken* token);
+  [[nodiscard]] std::size_t scanCloseTag(std::size_t begin, HtmlCloseToken* token);
+
+  // Text runs up to the next '<' or the end of the content, so the result is never npos
+  [[nodiscard]] std::size_t scanText(std::size_t begin);
+
+  // Content of a raw-text or RCDATA element (script, style, textarea, title), found with a single
+  // case-insensitive search for its end tag. Returns the position of the end tag, or begin for other tags.
+  [[nodiscard]] std::size_t scanRawText(std::size_t begin, Tag tag);
+
+  // Markup starting with "<!" or "<?". Comment and CDATA bodies may contain '>' and are
+  // scanned for their terminator directly; the others end at the next '>'.
+  [[nodiscard]] std::size_t scanMarkup(std::size_t begin, HtmlMarkupToken* token);
+
+  // Wrap text in a token, copying it into the string pool if there is one
+  [[nodiscard]] HtmlTextToken makeTextToken(std::size_t begin, std::size_t end);
+
+  // Where the text after pos begins in memory: the end of the string pool if there is one, otherwise
+  // the content itself. Passed to sinks to delimit the text of an element.
+  [[nodiscard]] const char* textCursor(std::size_t pos) const {
+    return string_pool_ ? string_pool_->GetCursor() : content_.data() + pos;
   }
 
+  // Start of the next token in content_
+  std::size_t pos_{0};
+
+  // Tag of the last open token. Raw-text elements continue with their content, which may span chunks.
+  Tag raw_text_tag_{Tag::kUnknown};
+
+  // Set by the scan steps when they ran into the end of the content, so more input could change their result
+  bool reached_end_{false};
+
  private:
   // Delimiter constants for tag parsing
   static constexpr std::string_view kOpenTagDelimiters = " />\t\n\r>";
   static constexpr std::string_view kCloseTagDelimiters = "> \t\n\r";
+  static constexpr std::string_view kAttributeNameDelimiters = " \t\n\r\f/>=";
+  static constexpr std::string_view kUnquotedValueDelimiters = " \t\n\r\f>";
+
+  [[nodiscard]] std::size_t scanDelimitedMarkup(std::size_t body_begin, std::string_view terminator,
+                                                HtmlMarkupToken* token);
+
+  // FindIgnoreAsciiCase() in content_, counting the bytes it reads
+  [[nodiscard]] std::size_t findIgnoreAsciiCase(std::size_t begin, std::string_view needle);
+
+  // Where a search from begin for target may start: begin, or the position the same search reached before the
+  // content grew. Nothing the search ruled out is read again.
+  [[nodiscard]] std::size_t resumePosition(std::size_t begin, char target) const;
+  void suspendSearch(std::size_t begin, char target, std::size_t resume);
+
+  [[nodiscard]] std::string_view extractTagName(std::size_t* begin, std::string_view delimiters);
+  [[nodiscard]] bool skipToTagEnd(std::size_t* begin);
 
-  [[nodiscard]] std::size_t parseOpenTag(std::size_t begin) const;
-  [[nodiscard]] std::size_t parseCloseTag(std::size_t begin) const;
-  [[nodiscard]] std::size_t parseTextContent(std::size_t begin) const;
+  // Tokenize attributes (quoted, unquoted and boolean) up to and including the closing '>'.
+  // Names and values are stored as views into content_, so no attribute text is copied.
+  [[nodiscard]] bool parseAttributes(std::size_t* begin, HtmlToken* token);
+  static void addAttribute(HtmlToken* token, std::string_view name, std::string_view value);
 
-  [[nodiscard]] std::string_view extractTagName(std::size_t* begin, std::string_view delimiters) const;
-  [[nodiscard]] bool skipToTagEnd(std::size_t* begin) const;
+  // Find the first structural position at or after begin holding target_char.
+  // Positions must be requested in non-decreasing order; the cursor only moves forward.
+  [[nodiscard]] std::size_t nextStructural(std::size_t begin, char target_char);
+  void skipStructuralsBefore(std::size_t pos);
 
   std::shared_ptr<StringPool> string_pool_;
 
-  FeedOpenTokenCallback feed_open_token_callback_;
-  FeedTextTokenCallback feed_text_token_callback_;
-  FeedCloseTokenCallback feed_close_token_callback_;
+  StructuralIndex structural_index_;
+  std::size_t structural_cursor_{0};
+
+  // Position of content_[0] in the whole document
+  std::size_t position_offset_{0};
+
+  // The last search that ran into the end of the content, in document positions: searching from
+  // suspended_begin_ for suspended_target_ continues at suspended_resume_
+  std::size_t suspended_begin_{std::string::npos};
+  std::size_t suspended_resume_{0};
+  char suspended_target_{'\0'};
+
+  std::size_t bytes_scanned_{0};
+};
+
+// HTML tokenizer bound statically to its sink, so that the calls into the sink can be inlined
+template <HtmlTokenSink Sink>
+class BasicHtmlTokenParser : public HtmlTokenScanner {
+ public:
+  explicit BasicHtmlTokenParser(std::string_view content, std::shared_ptr<StringPool> string_pool, Sink sink = Sink{})
+      : HtmlTokenScanner(content, std::move(string_pool)), sink_(std::move(sink)) {}
+
+  BasicHtmlTokenParser(const BasicHtmlTokenParser&) = delete;
+  BasicHtmlTokenParser& operator=(const BasicHtmlTokenParser&) = delete;
+  BasicHtmlTokenParser(BasicHtmlTokenParser&&) = delete;
+  BasicHtmlTokenParser& operator=(BasicHtmlTokenParser&&) = delete;
+
+  ~BasicHtmlTokenParser() override = default;
+
+  [[nodiscard]] bool Parse() override {
+    pos_ = 0;
+    raw_text_tag_ = Tag::kUnknown;
+    buildStructuralIndex();
+    return parse(false);
+  }
+
+  /**
+   * @brief Tokenize another whole document with the same sink and string pool, reusing the buffers of the last one
+   * @param content Document to parse instead of the current content
+   * @return false on malformed input or if the sink rejected a token
+   */
+  [[nodiscard]] bool Parse(std::string_view content) {
+    beginDocument(content);
+    return Parse();
+  }
+
+  /**
+   * @brief Tokenize the next piece of a document that arrives in pieces
+   *
+   * Buffers that grow in place are cheapest: a chunk at the address of the previous one, which must then be a
+   * prefix of it, only has its new bytes indexed, and consumed() keeps counting from the same start. A chunk at
+   * another address is indexed in full and must begin with the bytes after the last consumed() ones. Either way,
+   * the searches of a pending raw-text element, comment, text run or quoted value continue where they stopped.
+   *
+   * @param chunk The current chunk grown in place, or the unconsumed tail of the previous chunk followed by new data
+   * @param is_last true if the document ends with this chunk
+   * @return false on malformed input or if the sink rejected a token. Unless is_last, a trailing token that may
+   *         continue in the next chunk is left unconsumed; token positions count from the start of the document.
+   */
+  [[nodiscard]] bool ParseChunk(std::string_view chunk, bool is_last) {
+    beginChunk(chunk);
+    return parse(!is_last);
+  }
+
+  [[nodiscard]] Sink& sink() noexcept {
+    return sink_;
+  }
+
+  [[nodiscard]] const Sink& sink() const noexcept {
+    return sink_;
+  }
+
+ private:
+  [[nodiscard]] bool parse(bool partial) {
+    // Stage 2: tokenize by jumping between structural positions
+    while (pos_ < content_.length()) {
+      reached_end_ = false;
+      const StepResult result = parseToken(partial);
+      if (result != StepResult::kToken) {
+        return result == StepResult::kIncomplete;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] StepResult parseToken(bool partial) {
+    const std::size_t begin = pos_;
+    if (raw_text_tag_ != Tag::kUnknown) {
+      const std::size_t end = scanRawText(begin, raw_text_tag_);
+      if (partial && reached_end_) {
+        return StepResult::kIncomplete;
+      }
+      raw_text_tag_ = Tag::kUnknown;
+      return feedText(begin, end);
+    }
+
+    if (content_[begin] != '<') {
+      const std::size_t end = scanText(begin);
+      if (partial && reached_end_) {
+        return StepResult::kIncomplete;
+      }
+      return feedText(begin, end);
+    }
+
+    const char next = begin + 1 < content_.length() ? content_[begin + 1] : '\0';
+    if (next == '/') {
+      HtmlCloseToken token;
+      const std::size_t end = scanCloseTag(begin, &token);
+      if (end == std::string::npos) {
+        return failure(partial);
+      }
+      if (!sink_.FeedCloseToken(std::move(token), textCursor(begin))) {
+        return StepResult::kError;
+      }
+      pos_ = end;
+      return StepResult::kToken;
+    }
+
+    if (next == '!' || next == '?') {
+      HtmlMarkupToken token;
+      const std::size_t end = scanMarkup(begin, &token);
+      if (end == std::string::npos || (partial && reached_end_)) {
+        return failure(partial);
+      }
+      if constexpr (HtmlMarkupTokenSink<Sink>) {
+        if (!sink_.FeedMarkupToken(std::move(token))) {
+          return StepResult::kError;
+        }
+      }
+      pos_ = end;
+      return StepResult::kToken;
+    }
+
+    HtmlToken token;
+    const std::size_t end = scanOpenTag(begin, &token);
+    if (end == std::string::npos) {
+      return failure(partial);
+    }
+    const Tag tag = token.tag;
+    if (!sink_.FeedOpenToken(std::move(token), textCursor(end))) {
+      return StepResult::kError;
+    }
+    raw_text_tag_ = tag;
+    pos_ = end;
+    return StepResult::kToken;
+  }
+
+  [[nodiscard]] StepResult feedText(std::size_t begin, std::size_t end) {
+    if (end != begin && !sink_.FeedTextToken(makeTextToken(begin, end))) {
+      return StepResult::kError;
+    }
+    pos_ = end;
+    return StepResult::kToken;
+  }
+
+  // A token cut off by the end of a chunk is retried with the next one
+  [[nodiscard]] StepResult failure(bool partial) const {
+    return partial && reached_end_ ? StepResult::kIncomplete : StepResult::kError;
+  }
+
+  Sink sink_;
+};
+
+// Sink forwarding every token to a std::function, for handlers bound at run time. Unset handlers accept everything.
+struct HtmlCallbackSink {
+  std::function<bool(HtmlToken&&, const char*)> feed_open_token;
+  std::function<bool(HtmlTextToken&&)> feed_text_token;
+  std::function<bool(HtmlCloseToken&&, const char*)> feed_close_token;
+  std::function<bool(HtmlMarkupToken&&)> feed_markup_token;
+
+  bool FeedOpenToken(HtmlToken&& token, const char* text_begin) {
+    return !feed_open_token || feed_open_token(std::move(token), text_begin);
+  }
+
+  bool FeedTextToken(HtmlTextToken&& token) {
+    return !feed_text_token || feed_text_token(std::move(token));
+  }
+
+  bool FeedCloseToken(HtmlCloseToken&& token, const char* text_end) {
+    return !feed_close_token || feed_close_token(std::move(token), text_end);
+  }
+
+  bool FeedMarkupToken(HtmlMarkupToken&& token) {
+    return !feed_markup_token || feed_markup_token(std::move(token));
+  }
+};
+
+extern template class BasicHtmlTokenParser<HtmlCallbackSink>;
+
+// Tokenizer with callbacks set at run time. Hot paths should use BasicHtmlTokenParser with a concrete sink instead.
+class HtmlTokenParser final : public BasicHtmlTokenParser<HtmlCallbackSink> {
+ public:
+  using FeedOpenTokenCallback = std::function<bool(HtmlToken&&, const char*)>;
+  using FeedTextTokenCallback = std::function<bool(HtmlTextToken&&)>;
+  using FeedCloseTokenCallback = std::function<bool(HtmlCloseToken&&, const char*)>;
+  using FeedMarkupTokenCallback = std::function<bool(HtmlMarkupToken&&)>;
+
+  explicit HtmlTokenParser(std::string_view content, std::shared_ptr<StringPool> string_pool)
+      : BasicHtmlTokenParser(content, std::move(string_pool)) {}
+
+  ~HtmlTokenParser() override = default;
+
+  void set_feed_open_token_callback(FeedOpenTokenCallback&& callback) {
+    sink().feed_open_token = std::move(callback);
+  }
+
+  void set_feed_text_token_callback(FeedTextTokenCallback&& callback) {
+    sink().feed_text_token = std::move(callback);
+  }
+
+  void set_feed_close_token_callback(FeedCloseTokenCallback&& callback) {
+    sink().feed_close_token = std::move(callback);
+  }
+
+  // Comments, doctypes, CDATA sections and processing instructions are skipped without a copy unless set
+  void set_feed_markup_token_callback(FeedMarkupTokenCallback&& callback) {
+    sink().feed_markup_token = std::move(callback);
+  }
 };
 
 }  // namespace arboris
@@ -0,0 +1,189 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/main_content.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "dom/subtree_stats.hpp"
+#include "dom/tree_index.hpp"
+#include "string/string.hpp"
+
+namespace arboris {
+namespace {
+
+// Substrings of class and id values, from the heuristics of Mozilla's Readability. The first kPositiveHintCount
+// are positive, the others negative.
+constexpr std::array<std::string_view, 36> kHints = {
+    // Positive
+    "article", "body", "content", "entry", "hentry", "h-entry", "main", "page", "pagination", "post", "text", "blog",
+    "story",
+    // Negative
+    "banner", "combx", "comment", "contact", "foot", "masthead", "media", "menu", "meta", "nav", "outbrain",
+    "promo", "related", "scroll", "share", "shoutbox", "sidebar", "skyscraper", "social", "sponsor", "shopping",
+    "tags", "widget",
+};
+constexpr std::size_t kPositiveHintCount = 13;
+constexpr std::uint64_t kPositiveHintBits = (std::uint64_t{1} << kPositiveHintCount) - 1;
+
+// Bit i of entry c is set when kHints[i] starts with c, so each position of a value is compared with a few hints
+constexpr std::array<std::uint64_t, 128> kHintsByFirstChar = [] {
+  std::array<std::uint64_t, 128> table{};
+  for (std::size_t i = 0; i < kHints.size(); ++i) {
+    table[static_cast<unsigned char>(kHints[i].front())] |= std::uint64_t{1} << i;
+  }
+  return table;
+}();
+
+constexpr double kHintWeight = 25.0;
+// A paragraph scores 1, plus 1 per this many bytes up to kMaxLengthScore
+constexpr double kBytesPerPoint = 100.0;
+constexpr double kMaxLengthScore = 3.0;
+
+// Hints match anywhere in the value, ignoring ASCII case; folded receives the lowercased value
+double HintWeight(std::string_view value, std::string* folded) {
+  folded->resize(value.size());
+  std::transform(value.begin(), value.end(), folded->begin(), ToLowerAscii);
+
+  std::uint64_t found = 0;
+  for (std::size_t i = 0; i < folded->size(); ++i) {
+    const auto first = static_cast<unsigned char>((*folded)[i]);
+    std::uint64_t candidates = first < kHintsByFirstChar.size() ? kHintsByFirstChar[first] & ~found : 0;
+    while (candidates != 0) {
+      const int hint = std::countr_zero(candidates);
+      candidates &= candidates - 1;
+      if (std::string_view(*folded).substr(i).starts_with(kHints[hint])) {
+        found |= std::uint64_t{1} << hint;
+      }
+    }
+  }
+  const double positive = (found & kPositiveHintBits) != 0 ? kHintWeight : 0.0;
+  const double negative = (found & ~kPositiveHintBits) != 0 ? kHintWeight : 0.0;
+  return positive - negative;
+}
+
+// Prior of a candidate before its paragraphs are counted
+double InitialScore(const TagNode& node, std::string* folded) {
+  double score = HintWeight(node.classes().raw(), folded) + HintWeight(node.id(), folded);
+  switch (node.tag()) {
+    case Tag::kArticle:
+    case Tag::kMain:
+      score += 10.0;
+      break;
+    case Tag::kDiv:
+    case Tag::kSection:
+      score += 5.0;
+      break;
+    default:
+      break;
+  }
+  return score;
+}
+
+// Posting lists of several tags merged into document order
+std::vector<const TagNode*> MergeByTags(const DOMIndexer& indexer, std::span<const Tag> tags) {
+  std::vector<const TagNode*> merged;
+  std::vector<const TagNode*> next;
+  for (const Tag tag : tags) {
+    const PostingList nodes = indexer.FindByTag(tag);
+    next.clear();
+    next.reserve(merged.size() + nodes.size());
+    std::merge(merged.begin(), merged.end(), nodes.begin(), nodes.end(), std::back_inserter(next), InBefore);
+    merged.swap(next);
+  }
+  merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+  return merged;
+}
+
+}  // anonymous namespace
+
+MainContent ExtractMainContent(const DOMManager& manager, const MainContentOptions& options) {
+  const DOMIndexer& indexer = manager.dom_indexer();
+  const std::vector<const TagNode*> candidates = MergeByTags(indexer, options.candidate_tags);
+  constexpr std::array<Tag, 2> kParagraphTags = {Tag::kP, Tag::kPre};
+  const std::vector<const TagNode*> paragraphs = MergeByTags(indexer, kParagraphTags);
+  const SubtreeStats stats = manager.flat_document() != nullptr ? SubtreeStats(*manager.flat_document())
+                                                                : SubtreeStats(*manager.root());
+
+  // Walk both lists in document order, keeping the chain of candidates that contain the current paragraph
+  std::vector<std::optional<double>> scores(candidates.size());
+  std::vector<std::size_t> open_candidates;
+  std::size_t next_candidate = 0;
+  std::string folded;
+  auto close_until = [&](const BaseNode& node) {
+    while (!open_candidates.empty() && !IsAncestor(*candidates[open_candidates.back()], node)) {
+      open_candidates.pop_back();
+    }
+  };
+  auto add_score = [&](std::size_t candidate, double score) {
+    if (!scores[candidate]) {
+      scores[candidate] = InitialScore(*candidates[candidate], &folded);
+    }
+    *scores[candidate] += score;
+  };
+
+  for (const TagNode* paragraph : paragraphs) {
+    for (; next_candidate < candidates.size() && candidates[next_candidate]->in() < paragraph->in(); ++next_candidate) {
+      close_until(*candidates[next_candidate]);
+      open_candidates.push_back(next_candidate);
+    }
+    close_until(*paragraph);
+    if (open_candidates.empty()) {
+      continue;
+    }
+
+    const SubtreeTotals totals = stats.Totals(*paragraph);
+    const std::uint32_t bytes = totals.text_bytes - totals.link_text_bytes;
+    if (bytes < options.min_paragraph_bytes) {
+      continue;
+    }
+    const double score = 1.0 + std::min(bytes / kBytesPerPoint, kMaxLengthScore);
+    add_score(open_candidates.back(), score);
+    if (open_candidates.size() > 1) {
+      add_score(open_candidates[open_candidates.size() - 2], score / 2);
+    }
+  }
+
+  MainContent content;
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    if (scores[i]) {
+      const double score = *scores[i] * (1.0 - stats.Totals(*candidates[i]).link_density());
+      if (content.node == nullptr || score > content.score) {
+        content.node = candidates[i];
+        content.score = score;
+      }
+    }
+  }
+
+  if (content.node == nullptr) {
+    // No paragraphs: the most text outside links, ties going to the innermost candidate
+    std::uint32_t best_bytes = 0;
+    for (const TagNode* candidate : candidates) {
+      const SubtreeTotals totals = stats.Totals(*candidate);
+      const std::uint32_t bytes = totals.text_bytes - totals.link_text_bytes;
+      if (bytes > 0 && bytes >= best_bytes) {
+        content.node = candidate;
+        content.score = 0.0;
+        best_bytes = bytes;
+      }
+    }
+  }
+
+  if (content.node != nullptr) {
+    ExtractText(*content.node, options.text, &content.text);
+  }
+  return content;
+}
+
+}  // namespace arboris
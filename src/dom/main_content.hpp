@@ -0,0 +1,61 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_MAIN_CONTENT_HPP_
+#define SRC_DOM_MAIN_CONTENT_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "dom/tag_node.hpp"
+#include "dom/text_extractor.hpp"
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+struct MainContentOptions {
+  // Elements that may hold the main content
+  std::vector<Tag> candidate_tags = {Tag::kArticle, Tag::kMain, Tag::kSection, Tag::kDiv};
+  // Paragraphs with less text, links excluded, do not count
+  std::uint32_t min_paragraph_bytes = 25;
+  // How the text of the winner is extracted; boilerplate inside it is left out
+  TextExtractionOptions text = {
+      .block_separators = true,
+      .excluded_tags = {Tag::kScript, Tag::kStyle, Tag::kNoscript, Tag::kTemplate, Tag::kNav, Tag::kAside,
+                        Tag::kFooter, Tag::kForm, Tag::kButton},
+  };
+};
+
+struct MainContent {
+  // Root of the main content, or nullptr if no candidate holds any text
+  const TagNode* node = nullptr;
+  // Score of node; only meaningful compared with other elements of the same page
+  double score = 0.0;
+  // Cleaned text of node
+  std::string text;
+};
+
+/**
+ * @brief Find the element holding the main content of a page, readability style, and extract its text
+ *
+ * Every paragraph (p or pre) scores by its text outside links, and adds its score to its closest candidate
+ * ancestor and half of it to the next one. A candidate's total, plus a bonus for its tag and class and id hints
+ * such as "article" or "sidebar", is scaled by the share of its text outside links, and the highest wins.
+ * Candidates and paragraphs come from the DOMIndexer posting lists and are matched up by a single merge over
+ * their Euler tour intervals; text and link totals come from SubtreeStats, built from the FlatDocument when the
+ * manager has one. Pages without paragraphs fall back to the innermost candidate with the most text.
+ *
+ * @param manager Parsed document
+ * @param options Candidates, thresholds and text extraction
+ * @return The winner and its text
+ */
+[[nodiscard]] MainContent ExtractMainContent(const DOMManager& manager, const MainContentOptions& options = {});
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_MAIN_CONTENT_HPP_
@@ -0,0 +1,134 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/subtree_stats.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <span>
+
+namespace arboris {
+
+SubtreeStats::SubtreeStats(const TagNode& root, const SubtreeStatsOptions& options) : base_(root.in()) {
+  std::bitset<kTagCount> excluded;
+  for (const Tag tag : options.excluded_tags) {
+    excluded.set(static_cast<std::size_t>(tag));
+  }
+
+  // Counts of each node at offset in() - base_ + 1, turned into prefix sums below. Timestamps of the nodes that
+  // are left out, and close timestamps, keep zero counts.
+  prefix_.resize(1);
+  auto counts_at = [this](const BaseNode& node) -> SubtreeTotals& {
+    const std::uint32_t offset = node.in() - base_ + 1;
+    if (offset >= prefix_.size()) {
+      prefix_.resize(offset + 1);
+    }
+    return prefix_[offset];
+  };
+
+  // Preorder walk without a stack, counting the a elements that are open
+  std::uint32_t open_links = 0;
+  std::uint32_t last_timestamp = 0;
+  const BaseNode* node = &root;
+  while (node != nullptr) {
+    last_timestamp = std::max({last_timestamp, node->in(), node->out()});
+    const TagNode* tag_node = node->As<TagNode>();
+    if (tag_node == nullptr) {
+      SubtreeTotals& counts = counts_at(*node);
+      const auto bytes = static_cast<std::uint32_t>(node->text_content().size());
+      counts.text_bytes = bytes;
+      counts.link_text_bytes = open_links > 0 ? bytes : 0;
+    } else if (!excluded.test(static_cast<std::size_t>(tag_node->tag())) || node == &root) {
+      SubtreeTotals& counts = counts_at(*node);
+      counts.elements = 1;
+      if (tag_node->tag() == Tag::kA) {
+        counts.links = 1;
+        ++open_links;
+      }
+      if (tag_node->first_child() != nullptr) {
+        node = tag_node->first_child();
+        continue;
+      }
+      open_links -= tag_node->tag() == Tag::kA ? 1 : 0;
+    }
+
+    // Leave the node, and every ancestor it was the last descendant of
+    while (node != &root && node->next_sibling() == nullptr) {
+      node = node->parent();
+      open_links -= node->As<TagNode>()->tag() == Tag::kA ? 1 : 0;
+    }
+    node = node == &root ? nullptr : node->next_sibling();
+  }
+
+  accumulate(last_timestamp);
+}
+
+SubtreeStats::SubtreeStats(const FlatDocument& document, const SubtreeStatsOptions& options) : base_(0) {
+  std::bitset<kTagCount> excluded;
+  for (const Tag tag : options.excluded_tags) {
+    excluded.set(static_cast<std::size_t>(tag));
+  }
+
+  const std::span<const std::uint32_t> ins = document.ins();
+  const std::span<const std::uint32_t> outs = document.outs();
+  std::uint32_t last_timestamp = 0;
+  for (std::uint32_t id = 0; id < document.size(); ++id) {
+    last_timestamp = std::max({last_timestamp, ins[id], outs[id]});
+  }
+  prefix_.resize(last_timestamp + 2);
+
+  // Ids past which each open a element ends
+  std::vector<std::uint32_t> link_ends;
+  std::uint32_t id = 0;
+  while (id < document.size()) {
+    while (!link_ends.empty() && id >= link_ends.back()) {
+      link_ends.pop_back();
+    }
+    SubtreeTotals& counts = prefix_[ins[id] + 1];
+    if (document.node_type(id) == NodeType::kText) {
+      const auto bytes = static_cast<std::uint32_t>(document.text(id).size());
+      counts.text_bytes = bytes;
+      counts.link_text_bytes = link_ends.empty() ? 0 : bytes;
+    } else if (id != 0 && excluded.test(static_cast<std::size_t>(document.tag(id)))) {
+      id = document.subtree_end(id);
+      continue;
+    } else {
+      counts.elements = 1;
+      if (document.tag(id) == Tag::kA) {
+        counts.links = 1;
+        link_ends.push_back(document.subtree_end(id));
+      }
+    }
+    ++id;
+  }
+  accumulate(last_timestamp);
+}
+
+void SubtreeStats::accumulate(std::uint32_t last_timestamp) {
+  // Up to the close of the last node, which may have been left out
+  prefix_.resize(last_timestamp - base_ + 2);
+  for (std::size_t i = 1; i < prefix_.size(); ++i) {
+    const SubtreeTotals& previous = prefix_[i - 1];
+    SubtreeTotals& current = prefix_[i];
+    current.text_bytes += previous.text_bytes;
+    current.elements += previous.elements;
+    current.links += previous.links;
+    current.link_text_bytes += previous.link_text_bytes;
+  }
+}
+
+SubtreeTotals SubtreeStats::Totals(std::uint32_t in, std::uint32_t out) const {
+  ARBORIS_ASSERT(in >= base_ && in - base_ + 1 < prefix_.size(), "node is not in the indexed subtree.");
+  const std::uint32_t first = in - base_;
+  // Nodes that are never closed extend to the end of the subtree
+  const std::size_t end = out == 0 ? prefix_.size() - 1 : out - base_ + 1;
+  const SubtreeTotals& before = prefix_[first];
+  const SubtreeTotals& through = prefix_[end];
+  return {through.text_bytes - before.text_bytes, through.elements - before.elements, through.links - before.links,
+          through.link_text_bytes - before.link_text_bytes};
+}
+
+}  // namespace arboris
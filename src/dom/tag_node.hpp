@@ -7,11 +7,8 @@
 #ifndef SRC_DOM_TAG_NODE_HPP_
 #define SRC_DOM_TAG_NODE_HPP_
 
-#include <memory>
-#include <string>
-#include <unordered_map>
-#include <utility>
-#include <vector>
+#include <span>
+#include <string_view>
 
 #include "dom/base_node.hpp"
 #include "utils/html_tokens.hpp"
@@ -22,39 +19,72 @@ class TagNode final : public BaseNode {
  public:
   static constexpr NodeType kNodeType = NodeType::kTag;
 
-  explicit TagNode(std::uint32_t node_id, HtmlToken&& token, std::shared_ptr<TagNode> parent)
-      : BaseNode(kNodeType, node_id, std::move(parent)), html_token_(std::move(token)) {}
+  // attributes must outlive the node, e.g. a copy of token.attributes in the document's Arena
+  explicit TagNode(std::uint32_t node_id, const HtmlToken& token, std::span<const HtmlAttribute> attributes,
+                   TagNode* parent)
+      : BaseNode(kNodeType, node_id, parent),
+        tag_(token.tag),
+        attributes_(attributes),
+        classes_(token.classes),
+        id_(token.id) {}
 
-  [[nodiscard]] const std::vector<std::shared_ptr<BaseNode>>& children() const noexcept {
-    return children_;
+  [[nodiscard]] ChildRange children() const noexcept {
+    return ChildRange(first_child_);
   }
 
-  [[nodiscard]] const std::unordered_map<std::string, std::string>& attributes() const noexcept {
-    return html_token_.attributes;
+  [[nodiscard]] BaseNode* first_child() const noexcept {
+    return first_child_;
   }
 
-  [[nodiscard]] const std::vector<std::string>& classes() const noexcept {
-    return html_token_.classes;
+  [[nodiscard]] BaseNode* last_child() const noexcept {
+    return last_child_;
+  }
+
+  [[nodiscard]] std::span<const HtmlAttribute> attributes() const noexcept {
+    return attributes_;
+  }
+
+  [[nodiscard]] const ClassList& classes() const noexcept {
+    return classes_;
+  }
+
+  [[nodiscard]] const HtmlAttribute* FindAttribute(std::string_view name) const {
+    return arboris::FindAttribute(attributes_, name);
   }
 
   [[nodiscard]] std::string_view id() const noexcept {
-    return html_token_.id;
+    return id_;
   }
 
   [[nodiscard]] Tag tag() const noexcept {
-    return html_token_.tag;
+    return tag_;
   }
 
-  void AddChild(std::shared_ptr<BaseNode> child) {
+  void AddChild(BaseNode* child) {
     ARBORIS_ASSERT(child != nullptr, "child must not be nullptr.");
-    children_.emplace_back(std::move(child));
+    if (last_child_ == nullptr) {
+      first_child_ = child;
+    } else {
+      last_child_->set_next_sibling(child);
+    }
+    last_child_ = child;
   }
 
  private:
-  const HtmlToken html_token_;
-  std::vector<std::shared_ptr<BaseNode>> children_;
+  const Tag tag_;
+  const std::span<const HtmlAttribute> attributes_;
+  const ClassList classes_;
+  const std::string_view id_;
+
+  BaseNode* first_child_{nullptr};
+  BaseNode* last_child_{nullptr};
 };
 
+// Document order of elements, by their Euler tour in() timestamps
+[[nodiscard]] inline bool InBefore(const TagNode* lhs, const TagNode* rhs) noexcept {
+  return lhs->in() < rhs->in();
+}
+
 }  // namespace arboris
 
 #endif  // SRC_DOM_TAG_NODE_HPP_
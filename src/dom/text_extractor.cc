@@ -0,0 +1,122 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/text_extractor.hpp"
+
+#include <bitset>
+#include <cctype>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+namespace {
+
+// Appends text to the output, holding back the separator owed before the next text until it is known there is
+// one, so the output never starts or ends with a separator
+class TextWriter {
+ public:
+  TextWriter(bool collapse_whitespace, std::string* out)
+      : collapse_whitespace_(collapse_whitespace), out_(out), begin_(out->size()) {}
+
+  void AddText(std::string_view text) {
+    if (!collapse_whitespace_) {
+      if (!text.empty()) {
+        flushSeparator();
+        out_->append(text);
+      }
+      return;
+    }
+
+    const std::size_t first = SkipWhitespace(text, 0);
+    if (first == text.length()) {
+      if (!text.empty()) {
+        addSeparator(' ');
+      }
+      return;
+    }
+    if (first > 0) {
+      addSeparator(' ');
+    }
+    flushSeparator();
+    AppendCollapsedWhitespace(text.substr(first), out_);
+    if (std::isspace(static_cast<unsigned char>(text.back()))) {
+      addSeparator(' ');
+    }
+  }
+
+  // Start or end of a block tag
+  void AddBlockBoundary() {
+    addSeparator('\n');
+  }
+
+  [[nodiscard]] std::size_t written() const {
+    return out_->size() - begin_;
+  }
+
+ private:
+  // A newline wins over a space
+  void addSeparator(char separator) {
+    if (pending_ != '\n') {
+      pending_ = separator;
+    }
+  }
+
+  void flushSeparator() {
+    // Without collapsing, whitespace is kept as written and only missing newlines are added
+    if (written() > 0 && (collapse_whitespace_ ? pending_ != '\0' : pending_ == '\n' && out_->back() != '\n')) {
+      out_->push_back(pending_);
+    }
+    pending_ = '\0';
+  }
+
+  const bool collapse_whitespace_;
+  std::string* const out_;
+  const std::size_t begin_;
+  char pending_{'\0'};
+};
+
+}  // anonymous namespace
+
+std::size_t ExtractText(const TagNode& subtree, const TextExtractionOptions& options, std::string* out) {
+  ARBORIS_ASSERT(out != nullptr, "out must not be nullptr.");
+  std::bitset<kTagCount> excluded;
+  for (const Tag tag : options.excluded_tags) {
+    excluded.set(static_cast<std::size_t>(tag));
+  }
+
+  TextWriter writer(options.collapse_whitespace, out);
+  // Preorder walk without a stack. An excluded element is passed over with its whole Euler tour interval in
+  // one step to its next sibling, so text nodes never look up their ancestors.
+  const BaseNode* node = subtree.first_child();
+  while (node != nullptr) {
+    if (const auto* tag_node = node->As<TagNode>()) {
+      if (!excluded.test(static_cast<std::size_t>(tag_node->tag()))) {
+        if (options.block_separators && IsBlockTag(tag_node->tag())) {
+          writer.AddBlockBoundary();
+        }
+        if (tag_node->first_child() != nullptr) {
+          node = tag_node->first_child();
+          continue;
+        }
+      }
+    } else {
+      writer.AddText(node->text_content());
+    }
+
+    // Leave the node, and every ancestor it was the last descendant of
+    while (node != &subtree && node->next_sibling() == nullptr) {
+      node = node->parent();
+      if (options.block_separators && node != &subtree && IsBlockTag(node->As<TagNode>()->tag())) {
+        writer.AddBlockBoundary();
+      }
+    }
+    node = node == &subtree ? nullptr : node->next_sibling();
+  }
+  return writer.written();
+}
+
+}  // namespace arboris
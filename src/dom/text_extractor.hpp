@@ -0,0 +1,39 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_TEXT_EXTRACTOR_HPP_
+#define SRC_DOM_TEXT_EXTRACTOR_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "dom/tag_node.hpp"
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+struct TextExtractionOptions {
+  // Replace every run of whitespace with one space, and drop whitespace at the start and end of the text
+  bool collapse_whitespace = true;
+  // Put a newline between the text of block tags (see IsBlockTag()), e.g. paragraphs and list items
+  bool block_separators = false;
+  // Elements whose text is left out together with their whole subtree
+  std::vector<Tag> excluded_tags = {Tag::kScript, Tag::kStyle};
+};
+
+/**
+ * @brief Append the text nodes of a subtree in document order
+ * @param subtree Element whose descendants' text is extracted; its own tag is never excluded
+ * @param options Whitespace handling, separators and excluded tags
+ * @param out Buffer to append to. Reusing it across calls avoids allocating.
+ * @return Number of bytes appended
+ */
+std::size_t ExtractText(const TagNode& subtree, const TextExtractionOptions& options, std::string* out);
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_TEXT_EXTRACTOR_HPP_
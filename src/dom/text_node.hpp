@@ -7,11 +7,8 @@
 #ifndef SRC_DOM_TEXT_NODE_HPP_
 #define SRC_DOM_TEXT_NODE_HPP_
 
-#include <memory>
-#include <string>
-#include <unordered_map>
-#include <utility>
-#include <vector>
+#include <cstdint>
+#include <string_view>
 
 #include "dom/base_node.hpp"
 
@@ -24,8 +21,8 @@ class TextNode final : public BaseNode {
  public:
   static constexpr NodeType kNodeType = NodeType::kText;
 
-  explicit TextNode(std::uint32_t node_id, std::string_view text_content, std::shared_ptr<TagNode> parent)
-    : BaseNode(kNodeType, node_id, std::move(parent)) {
+  explicit TextNode(std::uint32_t node_id, std::string_view text_content, TagNode* parent)
+    : BaseNode(kNodeType, node_id, parent) {
     set_text_content(text_content);
   }
 };
@@ -0,0 +1,111 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/token_cursor.hpp"
+
+#include <string>
+#include <utility>
+
+namespace arboris {
+
+TokenCursor::TokenCursor(std::string_view content, std::shared_ptr<StringPool> string_pool)
+    : HtmlTokenScanner(content, std::move(string_pool)) {
+  buildStructuralIndex();
+}
+
+std::optional<TokenCursor::Token> TokenCursor::Next() {
+  std::optional<Token> token = nextToken();
+  if (!token) {
+    last_token_ = LastToken::kNone;
+  } else if (const auto* open_token = std::get_if<HtmlToken>(&*token)) {
+    last_token_ = open_token->is_void_tag ? LastToken::kVoidOpen : LastToken::kOpen;
+  } else {
+    last_token_ = LastToken::kOther;
+  }
+  return token;
+}
+
+std::optional<TokenCursor::Token> TokenCursor::nextToken() {
+  if (raw_text_tag_ != Tag::kUnknown) {
+    const std::size_t begin = pos_;
+    pos_ = scanRawText(begin, raw_text_tag_);
+    raw_text_tag_ = Tag::kUnknown;
+    if (pos_ != begin) {
+      return makeTextToken(begin, pos_);
+    }
+  }
+
+  while (!failed_ && pos_ < content_.length()) {
+    const std::size_t begin = pos_;
+    if (content_[begin] != '<') {
+      pos_ = scanText(begin);
+      return makeTextToken(begin, pos_);
+    }
+
+    const char next = begin + 1 < content_.length() ? content_[begin + 1] : '\0';
+    if (next == '!' || next == '?') {
+      HtmlMarkupToken markup_token;
+      const std::size_t end = scanMarkup(begin, &markup_token);
+      failed_ = end == std::string::npos;
+      pos_ = failed_ ? begin : end;
+      continue;
+    }
+
+    if (next == '/') {
+      HtmlCloseToken token;
+      const std::size_t end = scanCloseTag(begin, &token);
+      failed_ = end == std::string::npos;
+      if (failed_) {
+        break;
+      }
+      pos_ = end;
+      return token;
+    }
+
+    HtmlToken token;
+    const std::size_t end = scanOpenTag(begin, &token);
+    failed_ = end == std::string::npos;
+    if (failed_) {
+      break;
+    }
+    pos_ = end;
+    raw_text_tag_ = token.tag;
+    return token;
+  }
+  return std::nullopt;
+}
+
+bool TokenCursor::SkipSubtree() {
+  if (last_token_ == LastToken::kVoidOpen) {
+    return true;
+  }
+  if (last_token_ != LastToken::kOpen) {
+    return false;
+  }
+
+  std::size_t depth = 1;
+  while (depth > 0) {
+    const std::optional<Token> token = Next();
+    if (!token) {
+      return false;
+    }
+
+    if (const auto* open_token = std::get_if<HtmlToken>(&*token)) {
+      depth += open_token->is_void_tag ? 0 : 1;
+    } else if (std::holds_alternative<HtmlCloseToken>(*token)) {
+      --depth;
+    }
+  }
+  return true;
+}
+
+bool TokenCursor::Parse() {
+  while (Next()) {
+  }
+  return !failed_;
+}
+
+}  // namespace arboris
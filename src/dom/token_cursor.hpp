@@ -0,0 +1,126 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_TOKEN_CURSOR_HPP_
+#define SRC_DOM_TOKEN_CURSOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+#include "dom/html_token_parser.hpp"
+#include "utils/html_tokens.hpp"
+
+namespace arboris {
+
+// Pull-based tokenizer: each Next() scans exactly one token, so callers can stop early or skip whole
+// elements without building a DOM. Comments, doctypes, CDATA sections and processing instructions are skipped.
+//
+//   TokenCursor cursor(html);
+//   for (const TokenCursor::Token& token : cursor) {
+//     if (auto* close = std::get_if<HtmlCloseToken>(&token); close && close->tag == Tag::kHead) break;
+//   }
+class TokenCursor final : public HtmlTokenScanner {
+ public:
+  using Token = std::variant<HtmlToken, HtmlTextToken, HtmlCloseToken>;
+
+  class Iterator {
+   public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = Token;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    explicit Iterator(TokenCursor* cursor) : cursor_(cursor), token_(cursor->Next()) {}
+
+    [[nodiscard]] const Token& operator*() const {
+      return *token_;
+    }
+
+    [[nodiscard]] const Token* operator->() const {
+      return &*token_;
+    }
+
+    Iterator& operator++() {
+      token_ = cursor_->Next();
+      return *this;
+    }
+
+    void operator++(int) {
+      ++*this;
+    }
+
+    [[nodiscard]] bool operator==(std::default_sentinel_t) const {
+      return !token_.has_value();
+    }
+
+   private:
+    TokenCursor* cursor_{nullptr};
+    std::optional<Token> token_;
+  };
+
+  // Text tokens are copied into string_pool if one is given, otherwise they are views into content.
+  // The structural index of the whole content is built up front.
+  explicit TokenCursor(std::string_view content, std::shared_ptr<StringPool> string_pool = nullptr);
+
+  TokenCursor(const TokenCursor&) = delete;
+  TokenCursor& operator=(const TokenCursor&) = delete;
+  TokenCursor(TokenCursor&&) = delete;
+  TokenCursor& operator=(TokenCursor&&) = delete;
+
+  ~TokenCursor() override = default;
+
+  /**
+   * @brief Scan the next token
+   * @return The token, or std::nullopt at the end of the content or after malformed input (see failed())
+   */
+  [[nodiscard]] std::optional<Token> Next();
+
+  /**
+   * @brief Skip the rest of the element whose open token was returned last, up to and including its close token
+   *
+   * A void element has no content, so nothing is skipped after it. Anything but an open token returned last
+   * leaves no element to skip.
+   *
+   * @return true if the close token was found or the element is void, false if the last token was not an open
+   *         token or the content ended or was malformed first
+   */
+  [[nodiscard]] bool SkipSubtree();
+
+  // Consume all remaining tokens. Returns false if the content is malformed.
+  [[nodiscard]] bool Parse() override;
+
+  // Single-pass range over the remaining tokens
+  [[nodiscard]] Iterator begin() {
+    return Iterator(this);
+  }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept {
+    return std::default_sentinel;
+  }
+
+  [[nodiscard]] bool failed() const noexcept {
+    return failed_;
+  }
+
+ private:
+  // Kind of the token Next() returned last, which SkipSubtree() starts from
+  enum class LastToken : std::uint8_t { kNone, kOpen, kVoidOpen, kOther };
+
+  // Scan the next token without recording its kind
+  std::optional<Token> nextToken();
+
+  bool failed_{false};
+  LastToken last_token_{LastToken::kNone};
+};
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_TOKEN_CURSOR_HPP_
@@ -0,0 +1,92 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "dom/tree_index.hpp"
+
+#include <bit>
+#include <utility>
+
+namespace arboris {
+
+const TagNode* Closest(const BaseNode& node, Tag tag) {
+  const TagNode* element = node.As<TagNode>();
+  if (element == nullptr) {
+    element = node.parent();
+  }
+  while (element != nullptr && element->tag() != tag) {
+    element = element->parent();
+  }
+  return element;
+}
+
+TreeIndex::TreeIndex(const TagNode& root) {
+  // Preorder walk without a stack, numbering depths on the way
+  std::uint32_t depth = 0;
+  const BaseNode* node = &root;
+  while (node != nullptr) {
+    ARBORIS_ASSERT(node->node_id() - root.node_id() == nodes_.size(), "node ids are not in preorder.");
+    nodes_.push_back(node);
+    depths_.push_back(depth);
+
+    const TagNode* tag_node = node->As<TagNode>();
+    if (tag_node != nullptr && tag_node->first_child() != nullptr) {
+      node = tag_node->first_child();
+      ++depth;
+      continue;
+    }
+    while (node != &root && node->next_sibling() == nullptr) {
+      node = node->parent();
+      --depth;
+    }
+    node = node == &root ? nullptr : node->next_sibling();
+  }
+
+  const std::uint32_t count = size();
+  for (std::uint32_t width = 2; width <= count; width *= 2) {
+    const std::vector<std::uint32_t>* previous = sparse_.empty() ? nullptr : &sparse_.back();
+    std::vector<std::uint32_t> level(count - width + 1);
+    for (std::uint32_t i = 0; i < level.size(); ++i) {
+      // Two halves of width / 2; the first level compares single nodes
+      const std::uint32_t left = previous != nullptr ? (*previous)[i] : i;
+      const std::uint32_t right = previous != nullptr ? (*previous)[i + width / 2] : i + 1;
+      level[i] = depths_[right] < depths_[left] ? right : left;
+    }
+    sparse_.push_back(std::move(level));
+  }
+}
+
+std::uint32_t TreeIndex::minDepthPosition(std::uint32_t begin, std::uint32_t end) const {
+  const std::uint32_t length = end - begin;
+  if (length == 1) {
+    return begin;
+  }
+  // Two overlapping ranges of the largest power of two that fits
+  const int level = std::bit_width(length) - 1;
+  const std::vector<std::uint32_t>& minima = sparse_[level - 1];
+  const std::uint32_t left = minima[begin];
+  const std::uint32_t right = minima[end - (std::uint32_t{1} << level)];
+  return depths_[right] < depths_[left] ? right : left;
+}
+
+const TagNode* TreeIndex::LowestCommonAncestor(const BaseNode& lhs, const BaseNode& rhs) const {
+  std::uint32_t first = position(lhs);
+  std::uint32_t second = position(rhs);
+  if (first == second) {
+    const TagNode* element = lhs.As<TagNode>();
+    return element != nullptr ? element : lhs.parent();
+  }
+  if (second < first) {
+    std::swap(first, second);
+  }
+  const BaseNode* earlier = nodes_[first];
+  if (IsAncestor(*earlier, *nodes_[second])) {
+    return earlier->As<TagNode>();
+  }
+  // Otherwise the shallowest node after the earlier one, up to the later one, is a child of their common ancestor
+  return nodes_[minDepthPosition(first + 1, second + 1)]->parent();
+}
+
+}  // namespace arboris
@@ -0,0 +1,108 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_DOM_TREE_INDEX_HPP_
+#define SRC_DOM_TREE_INDEX_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "dom/base_node.hpp"
+#include "dom/tag_node.hpp"
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+/**
+ * @brief Check whether a node lies strictly inside the subtree of another, in O(1) from their Euler tour intervals
+ * @param ancestor Candidate ancestor; the document root contains every other node
+ * @param node Candidate descendant
+ * @return true if ancestor is a proper ancestor of node
+ */
+[[nodiscard]] inline bool IsAncestor(const BaseNode& ancestor, const BaseNode& node) {
+  // The root and tags that are never closed have out() == 0 and extend to the end of the document
+  const std::uint32_t out = ancestor.out() == 0 ? std::numeric_limits<std::uint32_t>::max() : ancestor.out();
+  return ancestor.in() < node.in() && node.in() < out;
+}
+
+/**
+ * @brief Find the closest element with a given tag, like Element.closest()
+ * @param node Node to start from
+ * @param tag Tag to look for
+ * @return node itself if it has the tag, else its nearest ancestor with the tag, or nullptr if there is none
+ */
+[[nodiscard]] const TagNode* Closest(const BaseNode& node, Tag tag);
+
+// Depths and lowest common ancestors over a parsed subtree, usually the whole document:
+//
+//   const TreeIndex tree(*manager.root());
+//   const TagNode* common = tree.LowestCommonAncestor(*link, *heading);
+//
+// Node ids are assigned in preorder, so the subtree is the id range [root id, root id + size()) and every
+// column below is indexed by id. Lowest common ancestors come from a sparse table of range minimum depths over
+// that range, which makes each query O(1) after O(n log n) construction. The DOM must not change afterwards.
+class TreeIndex {
+ public:
+  explicit TreeIndex(const TagNode& root);
+
+  TreeIndex(const TreeIndex&) = delete;
+  TreeIndex& operator=(const TreeIndex&) = delete;
+  TreeIndex(TreeIndex&&) = default;
+  TreeIndex& operator=(TreeIndex&&) = default;
+  ~TreeIndex() = default;
+
+  // Number of nodes in the subtree, its root included
+  [[nodiscard]] std::uint32_t size() const noexcept {
+    return static_cast<std::uint32_t>(nodes_.size());
+  }
+
+  [[nodiscard]] const TagNode& root() const noexcept {
+    return *nodes_.front()->As<TagNode>();
+  }
+
+  /**
+   * @brief Get the number of edges between a node and the root
+   * @param node Node of the subtree
+   * @return 0 for the root, 1 for its children, and so on
+   */
+  [[nodiscard]] std::uint32_t Depth(const BaseNode& node) const {
+    return depths_[position(node)];
+  }
+
+  /**
+   * @brief Find the deepest element that is an ancestor of both nodes or one of them
+   * @param lhs Node of the subtree
+   * @param rhs Node of the subtree
+   * @return The common element; the parent of a text node passed as both arguments
+   */
+  [[nodiscard]] const TagNode* LowestCommonAncestor(const BaseNode& lhs, const BaseNode& rhs) const;
+
+  // Nodes of the subtree in preorder, i.e. by id starting at the root
+  [[nodiscard]] std::span<const BaseNode* const> nodes() const noexcept {
+    return nodes_;
+  }
+
+ private:
+  [[nodiscard]] std::uint32_t position(const BaseNode& node) const {
+    const std::uint32_t position = node.node_id() - nodes_.front()->node_id();
+    ARBORIS_ASSERT(position < nodes_.size() && nodes_[position] == &node, "node is not in the indexed subtree.");
+    return position;
+  }
+
+  // Position of the shallowest node in [begin, end), which must not be empty
+  [[nodiscard]] std::uint32_t minDepthPosition(std::uint32_t begin, std::uint32_t end) const;
+
+  std::vector<const BaseNode*> nodes_;
+  std::vector<std::uint32_t> depths_;
+  // sparse_[k - 1][i] is the position of the shallowest node in [i, i + 2^k)
+  std::vector<std::vector<std::uint32_t>> sparse_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_DOM_TREE_INDEX_HPP_
@@ -0,0 +1,51 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/query.hpp"
+
+#include <utility>
+
+#include "query/query_plan.hpp"
+
+namespace arboris {
+namespace {
+
+std::vector<TagNode*> SelectComplex(const ComplexSelector& selector, const DOMIndexer& indexer) {
+  std::vector<TagNode*> storage;
+  const PostingList first = MatchCompound(selector.compounds.front(), indexer, &storage);
+  std::vector<TagNode*> matches(first.begin(), first.end());
+  for (std::size_t i = 0; i < selector.combinators.size() && !matches.empty(); ++i) {
+    const PostingList candidates = MatchCompound(selector.compounds[i + 1], indexer, &storage);
+    matches = JoinCombinator(selector.combinators[i], matches, candidates);
+  }
+  return matches;
+}
+
+}  // anonymous namespace
+
+Query::Query(std::vector<ComplexSelector> selectors) : selectors_(std::move(selectors)) {}
+
+std::optional<Query> Query::Compile(std::string_view selectors) {
+  std::vector<ComplexSelector> parsed;
+  if (!ParseSelectorList(selectors, &parsed)) {
+    return std::nullopt;
+  }
+  return Query(std::move(parsed));
+}
+
+std::vector<TagNode*> Query::Select(const DOMIndexer& indexer) const {
+  if (selectors_.size() == 1) {
+    return SelectComplex(selectors_.front(), indexer);
+  }
+
+  std::vector<TagNode*> result;
+  for (const ComplexSelector& selector : selectors_) {
+    MergeMatches(SelectComplex(selector, indexer), &result);
+  }
+  return result;
+}
+
+}  // namespace arboris
@@ -0,0 +1,56 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_QUERY_HPP_
+#define SRC_QUERY_QUERY_HPP_
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/tag_node.hpp"
+#include "query/selector.hpp"
+
+namespace arboris {
+
+// A compiled CSS selector list, evaluated against the posting lists of a DOMIndexer:
+//
+//   const auto query = Query::Compile("meta[property^='og:']");
+//   for (TagNode* meta : query->Select(manager.dom_indexer())) { ... }
+//
+// Each compound selector starts from the shortest posting list among its tag, id and classes, and is then
+// joined to the matches of the compound on its left. Descendant and child combinators are merge joins over
+// the Euler tour intervals of both lists (see structural_join.hpp), never walks up the parents.
+class Query {
+ public:
+  /**
+   * @brief Compile a comma-separated selector list
+   * @param selectors CSS selectors, see ParseSelectorList() for what is supported
+   * @return The query, or std::nullopt if the selectors do not parse
+   */
+  [[nodiscard]] static std::optional<Query> Compile(std::string_view selectors);
+
+  /**
+   * @brief Find every element matching any of the selectors
+   * @param indexer Index of the document to search
+   * @return Matching elements in document order, each once
+   */
+  [[nodiscard]] std::vector<TagNode*> Select(const DOMIndexer& indexer) const;
+
+  [[nodiscard]] const std::vector<ComplexSelector>& selectors() const noexcept {
+    return selectors_;
+  }
+
+ private:
+  explicit Query(std::vector<ComplexSelector> selectors);
+
+  std::vector<ComplexSelector> selectors_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_QUERY_HPP_
@@ -0,0 +1,147 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/query_plan.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+#include "query/structural_join.hpp"
+
+namespace arboris {
+namespace {
+
+TagNode* NextElementSibling(const BaseNode& node) {
+  for (BaseNode* sibling = node.next_sibling(); sibling != nullptr; sibling = sibling->next_sibling()) {
+    if (auto* element = sibling->As<TagNode>()) {
+      return element;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<TagNode*> JoinNextSiblings(PostingList previous, PostingList candidates) {
+  std::vector<TagNode*> next;
+  next.reserve(previous.size());
+  for (const TagNode* node : previous) {
+    if (TagNode* sibling = NextElementSibling(*node)) {
+      next.push_back(sibling);
+    }
+  }
+  std::sort(next.begin(), next.end(), InBefore);
+
+  std::vector<TagNode*> result;
+  std::set_intersection(candidates.begin(), candidates.end(), next.begin(), next.end(), std::back_inserter(result),
+                        InBefore);
+  return result;
+}
+
+std::vector<TagNode*> JoinSubsequentSiblings(PostingList previous, PostingList candidates) {
+  // previous is sorted, so the first node seen under a parent is the earliest one
+  std::unordered_map<const TagNode*, std::uint32_t> first_in;
+  for (const TagNode* node : previous) {
+    first_in.try_emplace(node->parent(), node->in());
+  }
+
+  std::vector<TagNode*> result;
+  for (TagNode* candidate : candidates) {
+    const auto found = first_in.find(candidate->parent());
+    if (found != first_in.end() && found->second < candidate->in()) {
+      result.push_back(candidate);
+    }
+  }
+  return result;
+}
+
+}  // anonymous namespace
+
+// The posting lists of every condition an index answers are intersected, shortest first, and only the remaining
+// conditions are tested node by node
+PostingList MatchCompound(const CompoundSelector& compound, const DOMIndexer& indexer,
+                          std::vector<TagNode*>* storage) {
+  std::vector<PostingList> lists;
+  // Results of value lookups, which the lists may refer to
+  std::vector<std::vector<TagNode*>> lookups;
+  lookups.reserve(compound.attributes.size());
+  bool residual = false;
+
+  if (compound.tag != Tag::kUnknown) {
+    lists.push_back(indexer.FindByTag(compound.tag));
+  }
+  if (!compound.id.empty()) {
+    lists.push_back(indexer.FindAllById(compound.id));
+  }
+  for (const std::string& class_name : compound.classes) {
+    lists.push_back(indexer.FindByClass(class_name));
+  }
+  for (const AttributeSelector& attribute : compound.attributes) {
+    const AttributeIndex* index = indexer.FindAttributeIndex(attribute.name);
+    if (index == nullptr) {
+      residual = true;
+    } else if (attribute.op == AttributeOperator::kExists) {
+      lists.push_back(index->nodes());
+    } else if (index->values_indexed() && attribute.op == AttributeOperator::kEquals) {
+      lists.push_back(lookups.emplace_back(index->FindValue(attribute.value, attribute.ignore_case)));
+    } else if (index->values_indexed() && attribute.op == AttributeOperator::kPrefix && !attribute.value.empty()) {
+      lists.push_back(lookups.emplace_back(index->FindPrefix(attribute.value, attribute.ignore_case)));
+    } else {
+      // The element must still have the attribute
+      lists.push_back(index->nodes());
+      residual = true;
+    }
+  }
+  if (lists.empty()) {
+    lists.push_back(indexer.elements());
+  }
+
+  std::sort(lists.begin(), lists.end(), [](PostingList lhs, PostingList rhs) { return lhs.size() < rhs.size(); });
+  if (lists.size() == 1 && !residual && lookups.empty()) {
+    return lists.front();
+  }
+
+  storage->assign(lists.front().begin(), lists.front().end());
+  for (std::size_t i = 1; i < lists.size() && !storage->empty(); ++i) {
+    *storage = IntersectPostingLists(*storage, lists[i]);
+  }
+  if (residual) {
+    std::erase_if(*storage, [&compound](const TagNode* node) { return !compound.Matches(*node); });
+  }
+  return *storage;
+}
+
+bool NeedsScan(const CompoundSelector& compound, const DOMIndexer& indexer) {
+  if (compound.tag != Tag::kUnknown || !compound.id.empty() || !compound.classes.empty()) {
+    return false;
+  }
+  return std::none_of(compound.attributes.begin(), compound.attributes.end(), [&indexer](const auto& attribute) {
+    return indexer.FindAttributeIndex(attribute.name) != nullptr;
+  });
+}
+
+std::vector<TagNode*> JoinCombinator(Combinator combinator, PostingList left, PostingList right) {
+  switch (combinator) {
+    case Combinator::kDescendant:
+      return JoinDescendants(left, right);
+    case Combinator::kChild:
+      return JoinChildren(left, right);
+    case Combinator::kNextSibling:
+      return JoinNextSiblings(left, right);
+    case Combinator::kSubsequentSibling:
+      return JoinSubsequentSiblings(left, right);
+  }
+  return {};
+}
+
+void MergeMatches(PostingList matches, std::vector<TagNode*>* result) {
+  const auto middle = result->insert(result->end(), matches.begin(), matches.end());
+  std::inplace_merge(result->begin(), middle, result->end(), InBefore);
+  result->erase(std::unique(result->begin(), result->end()), result->end());
+}
+
+}  // namespace arboris
@@ -0,0 +1,47 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_QUERY_PLAN_HPP_
+#define SRC_QUERY_QUERY_PLAN_HPP_
+
+#include <vector>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/tag_node.hpp"
+#include "query/selector.hpp"
+
+namespace arboris {
+
+// Operators that Query and QuerySet evaluate selectors with. Every list is sorted by in().
+
+/**
+ * @brief Find the elements matching a compound selector
+ * @param compound Conditions on one element
+ * @param indexer Index of the document to search
+ * @param storage Holds the result when no posting list of the indexer holds exactly the matching elements
+ * @return Matching elements, a view of a posting list of indexer or of storage
+ */
+[[nodiscard]] PostingList MatchCompound(const CompoundSelector& compound, const DOMIndexer& indexer,
+                                        std::vector<TagNode*>* storage);
+
+// Whether no index answers any condition of compound, so MatchCompound() tests every element of the document
+[[nodiscard]] bool NeedsScan(const CompoundSelector& compound, const DOMIndexer& indexer);
+
+/**
+ * @brief Keep the elements of right that relate to an element of left through a combinator
+ * @param combinator How left and right elements relate, as in "left > right"
+ * @param left Matches of the compounds on the left of the combinator
+ * @param right Matches of the compound on the right of the combinator
+ * @return Matching elements of right
+ */
+[[nodiscard]] std::vector<TagNode*> JoinCombinator(Combinator combinator, PostingList left, PostingList right);
+
+// Add matches to result, keeping it sorted and free of duplicates
+void MergeMatches(PostingList matches, std::vector<TagNode*>* result);
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_QUERY_PLAN_HPP_
@@ -0,0 +1,110 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/query_set.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "query/query_plan.hpp"
+
+namespace arboris {
+
+std::optional<QuerySet> QuerySet::Compile(std::span<const std::string_view> selectors) {
+  QuerySet query_set;
+  std::vector<ComplexSelector> parsed;
+  for (const std::string_view text : selectors) {
+    if (!ParseSelectorList(text, &parsed)) {
+      return std::nullopt;
+    }
+    for (const ComplexSelector& selector : parsed) {
+      query_set.add(query_set.query_count_, selector);
+    }
+    ++query_set.query_count_;
+  }
+  return query_set;
+}
+
+void QuerySet::add(std::size_t query, const ComplexSelector& selector) {
+  std::size_t parent = kNoStep;
+  for (std::size_t i = 0; i < selector.compounds.size(); ++i) {
+    const std::size_t compound = internCompound(selector.compounds[i]);
+    // The first compound has no combinator; it is stored as kDescendant and never used
+    const Combinator combinator = i == 0 ? Combinator::kDescendant : selector.combinators[i - 1];
+
+    const auto shared = std::find_if(steps_.begin(), steps_.end(), [&](const Step& step) {
+      return step.parent == parent && step.combinator == combinator && step.compound == compound;
+    });
+    if (shared != steps_.end()) {
+      parent = shared - steps_.begin();
+    } else {
+      steps_.push_back({parent, combinator, compound, {}});
+      parent = steps_.size() - 1;
+    }
+  }
+  steps_[parent].queries.push_back(query);
+}
+
+std::size_t QuerySet::internCompound(const CompoundSelector& compound) {
+  const auto found = std::find(compounds_.begin(), compounds_.end(), compound);
+  if (found != compounds_.end()) {
+    return found - compounds_.begin();
+  }
+  compounds_.push_back(compound);
+  return compounds_.size() - 1;
+}
+
+std::vector<std::vector<TagNode*>> QuerySet::Select(const DOMIndexer& indexer) const {
+  // Matches of each compound, as views of posting lists or of their storage
+  std::vector<PostingList> compound_matches(compounds_.size());
+  std::vector<std::vector<TagNode*>> compound_storage(compounds_.size());
+
+  std::vector<std::size_t> scanned;
+  for (std::size_t i = 0; i < compounds_.size(); ++i) {
+    if (NeedsScan(compounds_[i], indexer)) {
+      scanned.push_back(i);
+    } else {
+      compound_matches[i] = MatchCompound(compounds_[i], indexer, &compound_storage[i]);
+    }
+  }
+  if (!scanned.empty()) {
+    // One pass over the document for all the compounds that have to visit every element
+    for (TagNode* node : indexer.elements()) {
+      for (const std::size_t i : scanned) {
+        if (compounds_[i].Matches(*node)) {
+          compound_storage[i].push_back(node);
+        }
+      }
+    }
+    for (const std::size_t i : scanned) {
+      compound_matches[i] = compound_storage[i];
+    }
+  }
+
+  std::vector<std::vector<TagNode*>> results(query_count_);
+  std::vector<PostingList> step_matches(steps_.size());
+  std::vector<std::vector<TagNode*>> step_storage(steps_.size());
+  for (std::size_t i = 0; i < steps_.size(); ++i) {
+    const Step& step = steps_[i];
+    if (step.parent == kNoStep) {
+      step_matches[i] = compound_matches[step.compound];
+    } else if (!step_matches[step.parent].empty()) {
+      step_storage[i] = JoinCombinator(step.combinator, step_matches[step.parent], compound_matches[step.compound]);
+      step_matches[i] = step_storage[i];
+    }
+
+    for (const std::size_t query : step.queries) {
+      if (results[query].empty()) {
+        results[query].assign(step_matches[i].begin(), step_matches[i].end());
+      } else {
+        MergeMatches(step_matches[i], &results[query]);
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace arboris
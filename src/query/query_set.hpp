@@ -0,0 +1,89 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_QUERY_SET_HPP_
+#define SRC_QUERY_QUERY_SET_HPP_
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/tag_node.hpp"
+#include "query/selector.hpp"
+
+namespace arboris {
+
+// Selector lists compiled together and evaluated as one plan, e.g. the fixed extraction rules run on every page:
+//
+//   const auto rules = QuerySet::Compile({"title", "meta[name=description i]", "a[href]", "img[src]"});
+//   const auto results = rules->Select(manager.dom_indexer());  // results[2] holds the links
+//
+// A compound selector used by several queries is matched once, selectors that start the same way share the
+// joins of that common part, and the compounds no index answers are tested together in a single pass over
+// the elements of the document.
+class QuerySet {
+ public:
+  /**
+   * @brief Compile selector lists
+   * @param selectors One comma-separated selector list per query, see ParseSelectorList()
+   * @return The queries, or std::nullopt if any of them does not parse
+   */
+  [[nodiscard]] static std::optional<QuerySet> Compile(std::span<const std::string_view> selectors);
+
+  [[nodiscard]] static std::optional<QuerySet> Compile(std::initializer_list<std::string_view> selectors) {
+    return Compile(std::span<const std::string_view>(selectors.begin(), selectors.size()));
+  }
+
+  /**
+   * @brief Evaluate every query
+   * @param indexer Index of the document to search
+   * @return For each query, in the order they were given, its matching elements in document order
+   */
+  [[nodiscard]] std::vector<std::vector<TagNode*>> Select(const DOMIndexer& indexer) const;
+
+  // Number of queries
+  [[nodiscard]] std::size_t size() const noexcept {
+    return query_count_;
+  }
+
+  // Distinct compound selectors and join steps of the plan, which shared parts make smaller than the queries
+  [[nodiscard]] std::size_t compound_count() const noexcept {
+    return compounds_.size();
+  }
+
+  [[nodiscard]] std::size_t step_count() const noexcept {
+    return steps_.size();
+  }
+
+ private:
+  static constexpr std::size_t kNoStep = static_cast<std::size_t>(-1);
+
+  // A node of the prefix tree of all selectors: the elements matching compounds_[compound] that relate through
+  // combinator to the matches of step parent. Parents precede their children in steps_.
+  struct Step {
+    std::size_t parent;
+    Combinator combinator;
+    std::size_t compound;
+    // Queries with a selector that ends here
+    std::vector<std::size_t> queries;
+  };
+
+  QuerySet() = default;
+  void add(std::size_t query, const ComplexSelector& selector);
+  std::size_t internCompound(const CompoundSelector& compound);
+
+  std::vector<CompoundSelector> compounds_;
+  std::vector<Step> steps_;
+  std::size_t query_count_{0};
+};
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_QUERY_SET_HPP_
@@ -0,0 +1,308 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/selector.hpp"
+
+#include <span>
+#include <string>
+#include <utility>
+
+#include "string/string.hpp"
+#include "utils/class_list.hpp"
+
+namespace arboris {
+namespace {
+
+bool IsSelectorSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+}
+
+bool IsIdentChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' ||
+         static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool Equals(std::string_view lhs, std::string_view rhs, bool ignore_case) {
+  return ignore_case ? EqualsIgnoreAsciiCase(lhs, rhs) : lhs == rhs;
+}
+
+// Shared by the DOM and the token forms of CompoundSelector::Matches()
+bool MatchesElement(const CompoundSelector& compound, Tag tag, std::string_view id, const ClassList& classes,
+                    std::span<const HtmlAttribute> attributes) {
+  if (compound.tag != Tag::kUnknown && tag != compound.tag) {
+    return false;
+  }
+  if (!compound.id.empty() && id != compound.id) {
+    return false;
+  }
+  for (const std::string& class_name : compound.classes) {
+    if (!classes.Contains(class_name)) {
+      return false;
+    }
+  }
+  for (const AttributeSelector& attribute : compound.attributes) {
+    if (!attribute.Matches(FindAttribute(attributes, attribute.name))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Recursive descent over the selector grammar. Every method returns false on a syntax error.
+class SelectorParser {
+ public:
+  explicit SelectorParser(std::string_view text) : text_(text) {}
+
+  bool ParseList(std::vector<ComplexSelector>* selectors) {
+    do {
+      skipSpaces();
+      ComplexSelector selector;
+      if (!parseComplex(&selector)) {
+        return false;
+      }
+      selectors->push_back(std::move(selector));
+    } while (consume(','));
+    return pos_ == text_.size();
+  }
+
+ private:
+  bool parseComplex(ComplexSelector* selector) {
+    CompoundSelector compound;
+    if (!parseCompound(&compound)) {
+      return false;
+    }
+    selector->compounds.push_back(std::move(compound));
+
+    while (true) {
+      const bool spaced = skipSpaces();
+      Combinator combinator = Combinator::kDescendant;
+      if (consume('>')) {
+        combinator = Combinator::kChild;
+      } else if (consume('+')) {
+        combinator = Combinator::kNextSibling;
+      } else if (consume('~')) {
+        combinator = Combinator::kSubsequentSibling;
+      } else if (!spaced || atEnd() || peek() == ',') {
+        return true;
+      }
+      skipSpaces();
+
+      if (!parseCompound(&compound)) {
+        return false;
+      }
+      selector->combinators.push_back(combinator);
+      selector->compounds.push_back(std::move(compound));
+    }
+  }
+
+  bool parseCompound(CompoundSelector* compound) {
+    *compound = {};
+    const std::size_t begin = pos_;
+    if (consume('*')) {
+      compound->tag = Tag::kUnknown;
+    } else if (!atEnd() && IsIdentChar(peek())) {
+      std::string name;
+      parseIdent(&name);
+      compound->tag = FromString(name);
+      // Custom elements have no Tag of their own to match against
+      if (compound->tag == Tag::kUnknown) {
+        return false;
+      }
+    }
+
+    while (!atEnd()) {
+      if (consume('#')) {
+        if (!parseIdent(&compound->id)) {
+          return false;
+        }
+      } else if (consume('.')) {
+        if (!parseIdent(&compound->classes.emplace_back())) {
+          return false;
+        }
+      } else if (consume('[')) {
+        if (!parseAttribute(&compound->attributes.emplace_back())) {
+          return false;
+        }
+      } else {
+        break;
+      }
+    }
+    return pos_ != begin;
+  }
+
+  bool parseAttribute(AttributeSelector* attribute) {
+    skipSpaces();
+    if (!parseIdent(&attribute->name)) {
+      return false;
+    }
+    skipSpaces();
+    if (consume(']')) {
+      return true;
+    }
+
+    if (consume('=')) {
+      attribute->op = AttributeOperator::kEquals;
+    } else {
+      if (atEnd()) {
+        return false;
+      }
+      switch (peek()) {
+        case '~':
+          attribute->op = AttributeOperator::kIncludes;
+          break;
+        case '|':
+          attribute->op = AttributeOperator::kDashMatch;
+          break;
+        case '^':
+          attribute->op = AttributeOperator::kPrefix;
+          break;
+        case '$':
+          attribute->op = AttributeOperator::kSuffix;
+          break;
+        case '*':
+          attribute->op = AttributeOperator::kSubstring;
+          break;
+        default:
+          return false;
+      }
+      ++pos_;
+      if (!consume('=')) {
+        return false;
+      }
+    }
+
+    skipSpaces();
+    if (!atEnd() && (peek() == '"' || peek() == '\'')) {
+      if (!parseString(&attribute->value)) {
+        return false;
+      }
+    } else if (!parseIdent(&attribute->value)) {
+      return false;
+    }
+
+    skipSpaces();
+    if (consume('i') || consume('I')) {
+      attribute->ignore_case = true;
+      skipSpaces();
+    } else if (consume('s') || consume('S')) {
+      skipSpaces();
+    }
+    return consume(']');
+  }
+
+  // A backslash escapes the next character
+  bool parseIdent(std::string* ident) {
+    ident->clear();
+    while (!atEnd()) {
+      if (peek() == '\\' && pos_ + 1 < text_.size()) {
+        ident->push_back(text_[pos_ + 1]);
+        pos_ += 2;
+      } else if (IsIdentChar(peek())) {
+        ident->push_back(text_[pos_++]);
+      } else {
+        break;
+      }
+    }
+    return !ident->empty();
+  }
+
+  bool parseString(std::string* value) {
+    const char quote = text_[pos_++];
+    value->clear();
+    while (!atEnd() && peek() != quote) {
+      if (peek() == '\\' && pos_ + 1 < text_.size()) {
+        ++pos_;
+      }
+      value->push_back(text_[pos_++]);
+    }
+    return consume(quote);
+  }
+
+  // Returns whether any whitespace was skipped
+  bool skipSpaces() {
+    const std::size_t begin = pos_;
+    while (!atEnd() && IsSelectorSpace(peek())) {
+      ++pos_;
+    }
+    return pos_ != begin;
+  }
+
+  bool consume(char c) {
+    if (atEnd() || peek() != c) {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  [[nodiscard]] bool atEnd() const {
+    return pos_ >= text_.size();
+  }
+
+  [[nodiscard]] char peek() const {
+    return text_[pos_];
+  }
+
+  const std::string_view text_;
+  std::size_t pos_{0};
+};
+
+}  // anonymous namespace
+
+bool AttributeSelector::Matches(const HtmlAttribute* attribute) const {
+  if (attribute == nullptr) {
+    return false;
+  }
+
+  const std::string_view actual = attribute->value;
+  switch (op) {
+    case AttributeOperator::kExists:
+      return true;
+    case AttributeOperator::kEquals:
+      return Equals(actual, value, ignore_case);
+    case AttributeOperator::kIncludes:
+      for (std::string_view word : ClassList(actual)) {
+        if (Equals(word, value, ignore_case)) {
+          return true;
+        }
+      }
+      return false;
+    case AttributeOperator::kDashMatch:
+      return Equals(actual, value, ignore_case) ||
+             (actual.size() > value.size() && actual[value.size()] == '-' &&
+              Equals(actual.substr(0, value.size()), value, ignore_case));
+    // As in CSS, an empty value never matches the substring operators
+    case AttributeOperator::kPrefix:
+      return !value.empty() && actual.size() >= value.size() &&
+             Equals(actual.substr(0, value.size()), value, ignore_case);
+    case AttributeOperator::kSuffix:
+      return !value.empty() && actual.size() >= value.size() &&
+             Equals(actual.substr(actual.size() - value.size()), value, ignore_case);
+    case AttributeOperator::kSubstring:
+      if (value.empty()) {
+        return false;
+      }
+      return ignore_case ? FindIgnoreAsciiCase(actual, 0, value) != std::string_view::npos
+                         : actual.find(value) != std::string_view::npos;
+  }
+  return false;
+}
+
+bool CompoundSelector::Matches(const TagNode& node) const {
+  return MatchesElement(*this, node.tag(), node.id(), node.classes(), node.attributes());
+}
+
+bool CompoundSelector::Matches(const HtmlToken& token) const {
+  return MatchesElement(*this, token.tag, token.id, token.classes, token.attributes);
+}
+
+bool ParseSelectorList(std::string_view text, std::vector<ComplexSelector>* selectors) {
+  ARBORIS_ASSERT(selectors != nullptr, "selectors must not be nullptr.");
+  selectors->clear();
+  return SelectorParser(text).ParseList(selectors);
+}
+
+}  // namespace arboris
@@ -0,0 +1,88 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_SELECTOR_HPP_
+#define SRC_QUERY_SELECTOR_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dom/tag_node.hpp"
+#include "utils/html_tokens.hpp"
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+enum class AttributeOperator : std::uint8_t {
+  kExists,     // [name]
+  kEquals,     // [name=value]
+  kIncludes,   // [name~=value], value is one of the whitespace-separated words
+  kDashMatch,  // [name|=value], value or value followed by '-'
+  kPrefix,     // [name^=value]
+  kSuffix,     // [name$=value]
+  kSubstring,  // [name*=value]
+};
+
+struct AttributeSelector {
+  std::string name;
+  AttributeOperator op = AttributeOperator::kExists;
+  std::string value;
+  // The i flag: compare values ignoring ASCII case
+  bool ignore_case = false;
+
+  /**
+   * @brief Check an attribute of an element against the selector
+   * @param attribute Attribute with the selector's name, or nullptr if the element has none
+   * @return true if the attribute matches
+   */
+  [[nodiscard]] bool Matches(const HtmlAttribute* attribute) const;
+
+  bool operator==(const AttributeSelector& other) const = default;
+};
+
+// Conditions on a single element, e.g. a.external[href^=http]
+struct CompoundSelector {
+  // Tag::kUnknown matches any tag
+  Tag tag = Tag::kUnknown;
+  std::string id;
+  std::vector<std::string> classes;
+  std::vector<AttributeSelector> attributes;
+
+  [[nodiscard]] bool Matches(const TagNode& node) const;
+
+  // Same test on the open token of an element, before or without a DOM
+  [[nodiscard]] bool Matches(const HtmlToken& token) const;
+
+  bool operator==(const CompoundSelector& other) const = default;
+};
+
+enum class Combinator : std::uint8_t {
+  kDescendant,         // A B
+  kChild,              // A > B
+  kNextSibling,        // A + B
+  kSubsequentSibling,  // A ~ B
+};
+
+// Compound selectors joined by combinators: combinators[i] relates compounds[i] to compounds[i + 1], and the
+// last compound describes the elements that are selected
+struct ComplexSelector {
+  std::vector<CompoundSelector> compounds;
+  std::vector<Combinator> combinators;
+};
+
+/**
+ * @brief Parse a comma-separated list of CSS selectors
+ * @param text Selectors, e.g. "meta[property^='og:'], link[rel=canonical i]"
+ * @param selectors Receives one complex selector per item of the list
+ * @return false on a syntax error, a pseudo-class, a namespace or a tag name that is not an HTML tag
+ */
+[[nodiscard]] bool ParseSelectorList(std::string_view text, std::vector<ComplexSelector>* selectors);
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_SELECTOR_HPP_
@@ -0,0 +1,160 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/streaming_matcher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace arboris {
+namespace {
+
+constexpr std::size_t kWordBits = 64;
+
+bool TestBit(const std::vector<std::uint64_t>& bits, std::size_t bit) {
+  return (bits[bit / kWordBits] >> (bit % kWordBits)) & 1U;
+}
+
+void SetBit(std::vector<std::uint64_t>* bits, std::size_t bit) {
+  (*bits)[bit / kWordBits] |= std::uint64_t{1} << (bit % kWordBits);
+}
+
+void OrBits(const std::vector<std::uint64_t>& from, std::vector<std::uint64_t>* to) {
+  for (std::size_t i = 0; i < from.size(); ++i) {
+    (*to)[i] |= from[i];
+  }
+}
+
+}  // anonymous namespace
+
+std::optional<StreamingMatcher> StreamingMatcher::Compile(std::span<const std::string_view> selectors,
+                                                          StreamMatchCallback on_match) {
+  std::vector<ComplexSelector> all;
+  std::vector<std::size_t> queries;
+  std::vector<ComplexSelector> parsed;
+  for (std::size_t query = 0; query < selectors.size(); ++query) {
+    if (!ParseSelectorList(selectors[query], &parsed)) {
+      return std::nullopt;
+    }
+    for (ComplexSelector& selector : parsed) {
+      all.push_back(std::move(selector));
+      queries.push_back(query);
+    }
+  }
+  return StreamingMatcher(std::move(all), std::move(queries), std::move(on_match));
+}
+
+StreamingMatcher::StreamingMatcher(std::vector<ComplexSelector> selectors, std::vector<std::size_t> queries,
+                                   StreamMatchCallback on_match)
+    : selectors_(std::move(selectors)), queries_(std::move(queries)), on_match_(std::move(on_match)) {
+  for (const ComplexSelector& selector : selectors_) {
+    first_bits_.push_back(bit_count_);
+    bit_count_ += selector.compounds.size();
+  }
+  frames_.resize(1);
+  Frame& document = frames_.front();
+  const std::size_t words = (bit_count_ + kWordBits - 1) / kWordBits;
+  for (Bits* bits : {&document.self, &document.ancestors, &document.last_child, &document.children}) {
+    bits->assign(words, 0);
+  }
+}
+
+StreamingMatcher::Frame& StreamingMatcher::pushFrame() {
+  ++depth_;
+  if (depth_ == frames_.size()) {
+    frames_.emplace_back();
+  }
+  Frame& frame = frames_[depth_];
+  const std::size_t words = frames_.front().self.size();
+  for (Bits* bits : {&frame.self, &frame.ancestors, &frame.last_child, &frame.children}) {
+    bits->assign(words, 0);
+  }
+  frame.queries.clear();
+  return frame;
+}
+
+bool StreamingMatcher::FeedOpenToken(HtmlToken&& token, const char* text_begin) {
+  Frame& frame = pushFrame();
+  const Frame& parent = frames_[depth_ - 1];
+  frame.tag = token.tag;
+  frame.text_begin = text_begin;
+
+  for (std::size_t i = 0; i < selectors_.size(); ++i) {
+    const ComplexSelector& selector = selectors_[i];
+    for (std::size_t k = 0; k < selector.compounds.size(); ++k) {
+      const std::size_t bit = first_bits_[i] + k;
+      if (k > 0) {
+        // Whether the prefix before this compound matches an element related to this one
+        const Bits* related = nullptr;
+        switch (selector.combinators[k - 1]) {
+          case Combinator::kDescendant:
+            related = &parent.ancestors;
+            break;
+          case Combinator::kChild:
+            related = &parent.self;
+            break;
+          case Combinator::kNextSibling:
+            related = &parent.last_child;
+            break;
+          case Combinator::kSubsequentSibling:
+            related = &parent.children;
+            break;
+        }
+        if (!TestBit(*related, bit - 1)) {
+          continue;
+        }
+      }
+      if (selector.compounds[k].Matches(token)) {
+        SetBit(&frame.self, bit);
+      }
+    }
+
+    const std::size_t last_bit = first_bits_[i] + selector.compounds.size() - 1;
+    if (TestBit(frame.self, last_bit) &&
+        std::find(frame.queries.begin(), frame.queries.end(), queries_[i]) == frame.queries.end()) {
+      frame.queries.push_back(queries_[i]);
+    }
+  }
+  frame.ancestors = parent.ancestors;
+  OrBits(frame.self, &frame.ancestors);
+
+  const bool is_void_tag = token.is_void_tag;
+  if (!frame.queries.empty()) {
+    frame.token = std::move(token);
+  }
+  if (is_void_tag) {
+    closeTop(text_begin);
+  }
+  return true;
+}
+
+bool StreamingMatcher::FeedCloseToken(HtmlCloseToken&& token, const char* text_end) {
+  if (depth_ == 0 || frames_[depth_].tag != token.tag) {
+    return false;
+  }
+  closeTop(text_end);
+  return true;
+}
+
+void StreamingMatcher::closeTop(const char* text_end) {
+  Frame& frame = frames_[depth_];
+  Frame& parent = frames_[depth_ - 1];
+  parent.last_child = frame.self;
+  OrBits(frame.self, &parent.children);
+
+  if (!frame.queries.empty() && on_match_) {
+    std::string_view text;
+    if (frame.text_begin != nullptr && text_end != nullptr) {
+      text = {frame.text_begin, text_end};
+    }
+    for (const std::size_t query : frame.queries) {
+      on_match_({query, &frame.token, text});
+    }
+  }
+  --depth_;
+}
+
+}  // namespace arboris
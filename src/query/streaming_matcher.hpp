@@ -0,0 +1,119 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_STREAMING_MATCHER_HPP_
+#define SRC_QUERY_STREAMING_MATCHER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dom/html_token_parser.hpp"
+#include "query/selector.hpp"
+#include "utils/html_tokens.hpp"
+
+namespace arboris {
+
+struct StreamMatch {
+  // Index of the selector list that matched
+  std::size_t query;
+  // Open token of the element: tag, id, classes and attributes, which are views into the document
+  const HtmlToken* element;
+  // Between the open and close tokens: the source, markup included, when the parser has no string pool, or the
+  // concatenated text when it has one. Empty for void elements.
+  std::string_view text;
+};
+
+using StreamMatchCallback = std::function<void(const StreamMatch&)>;
+
+// Token sink that matches selectors while the document is tokenized, without building a DOM:
+//
+//   auto matcher = StreamingMatcher::Compile({"a[href]", "meta[property^='og:']"}, on_match);
+//   StreamingMatchParser parser(html, nullptr, std::move(*matcher));
+//   parser.Parse();
+//
+// Only the open elements are kept, each with one bit per compound selector telling whether the selector prefix
+// ending with that compound matches the element, so memory is O(depth) whatever the size of the document.
+// A match is reported when its element closes, in the order elements close. Text ranges require the whole
+// document to be parsed at once with Parse(); elements that are never closed are not reported.
+class StreamingMatcher {
+ public:
+  /**
+   * @brief Compile selector lists for matching
+   * @param selectors One comma-separated selector list per query, see ParseSelectorList()
+   * @param on_match Called for each element and query it matches; an element matching several selectors of
+   *        the same list is reported once
+   * @return The matcher, or std::nullopt if any selector list does not parse
+   */
+  [[nodiscard]] static std::optional<StreamingMatcher> Compile(std::span<const std::string_view> selectors,
+                                                               StreamMatchCallback on_match);
+
+  [[nodiscard]] static std::optional<StreamingMatcher> Compile(std::initializer_list<std::string_view> selectors,
+                                                               StreamMatchCallback on_match) {
+    return Compile(std::span<const std::string_view>(selectors.begin(), selectors.size()), std::move(on_match));
+  }
+
+  bool FeedOpenToken(HtmlToken&& token, const char* text_begin);
+
+  bool FeedTextToken(HtmlTextToken&& /*token*/) {
+    return true;
+  }
+
+  // Fails on a close token that does not match the innermost open element, like DOMBuilder
+  bool FeedCloseToken(HtmlCloseToken&& token, const char* text_end);
+
+  // Number of open elements
+  [[nodiscard]] std::size_t depth() const noexcept {
+    return depth_;
+  }
+
+ private:
+  using Bits = std::vector<std::uint64_t>;
+
+  struct Frame {
+    Tag tag = Tag::kUnknown;
+    // Prefixes matching this element
+    Bits self;
+    // Prefixes matching this element or one of its ancestors
+    Bits ancestors;
+    // Prefixes matching the last element child closed so far, and any element child closed so far
+    Bits last_child;
+    Bits children;
+    // Queries matching this element, whose open token is then kept until it closes
+    std::vector<std::size_t> queries;
+    HtmlToken token;
+    const char* text_begin = nullptr;
+  };
+
+  StreamingMatcher(std::vector<ComplexSelector> selectors, std::vector<std::size_t> queries,
+                   StreamMatchCallback on_match);
+
+  Frame& pushFrame();
+  void closeTop(const char* text_end);
+
+  std::vector<ComplexSelector> selectors_;
+  // Query of each selector, and the bit of its first compound
+  std::vector<std::size_t> queries_;
+  std::vector<std::size_t> first_bits_;
+  std::size_t bit_count_{0};
+  StreamMatchCallback on_match_;
+
+  // frames_[0] stands for the document; frames above depth_ are kept for reuse
+  std::vector<Frame> frames_;
+  std::size_t depth_{0};
+};
+
+using StreamingMatchParser = BasicHtmlTokenParser<StreamingMatcher>;
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_STREAMING_MATCHER_HPP_
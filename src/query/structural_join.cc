@@ -0,0 +1,95 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "query/structural_join.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace arboris {
+namespace {
+
+// A tag that is never closed has out() == 0 and extends to the end of the document
+std::uint32_t SubtreeOut(const BaseNode& node) {
+  return node.out() == 0 ? std::numeric_limits<std::uint32_t>::max() : node.out();
+}
+
+// Element intervals are nested or disjoint, so an interval that started earlier contains a node unless it has
+// already ended
+bool EndsBefore(const BaseNode& ancestor, const BaseNode& node) {
+  return SubtreeOut(ancestor) < node.in();
+}
+
+// Walks nodes in document order while stack_ holds, outermost first, the ancestors containing the current node
+class AncestorStack {
+ public:
+  explicit AncestorStack(PostingList ancestors) : ancestors_(ancestors) {
+    stack_.reserve(16);
+  }
+
+  // Advance to node, which must not precede the previous one
+  void Seek(const TagNode& node) {
+    for (; next_ != ancestors_.size() && ancestors_[next_]->in() < node.in(); ++next_) {
+      pop(*ancestors_[next_]);
+      stack_.push_back(ancestors_[next_]);
+    }
+    pop(node);
+  }
+
+  // Innermost ancestor of the current node, or nullptr
+  [[nodiscard]] const TagNode* top() const {
+    return stack_.empty() ? nullptr : stack_.back();
+  }
+
+  // Whether no ancestor is left to contain the current node or a later one
+  [[nodiscard]] bool exhausted() const {
+    return stack_.empty() && next_ == ancestors_.size();
+  }
+
+ private:
+  void pop(const BaseNode& node) {
+    while (!stack_.empty() && EndsBefore(*stack_.back(), node)) {
+      stack_.pop_back();
+    }
+  }
+
+  const PostingList ancestors_;
+  std::size_t next_{0};
+  std::vector<const TagNode*> stack_;
+};
+
+}  // anonymous namespace
+
+std::vector<TagNode*> JoinDescendants(PostingList ancestors, PostingList nodes) {
+  std::vector<TagNode*> result;
+  AncestorStack stack(ancestors);
+  for (TagNode* node : nodes) {
+    stack.Seek(*node);
+    if (stack.top() != nullptr) {
+      result.push_back(node);
+    } else if (stack.exhausted()) {
+      break;
+    }
+  }
+  return result;
+}
+
+std::vector<TagNode*> JoinChildren(PostingList parents, PostingList nodes) {
+  std::vector<TagNode*> result;
+  AncestorStack stack(parents);
+  for (TagNode* node : nodes) {
+    // If the parent is in the list, it is the innermost listed ancestor
+    stack.Seek(*node);
+    if (stack.top() != nullptr && stack.top() == node->parent()) {
+      result.push_back(node);
+    } else if (stack.exhausted()) {
+      break;
+    }
+  }
+  return result;
+}
+
+}  // namespace arboris
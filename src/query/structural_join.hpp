@@ -0,0 +1,39 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_QUERY_STRUCTURAL_JOIN_HPP_
+#define SRC_QUERY_STRUCTURAL_JOIN_HPP_
+
+#include <vector>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/tag_node.hpp"
+
+namespace arboris {
+
+// Structural joins in the Stack-Tree-Desc style: both lists are walked once in document order while a stack
+// holds the ancestors whose Euler interval contains the current node, so a join costs O(|ancestors| + |nodes|)
+// whatever the shape of the tree.
+
+/**
+ * @brief Keep the nodes that have a proper ancestor in ancestors, as in an "A B" selector
+ * @param ancestors Nodes sorted by in()
+ * @param nodes Nodes sorted by in()
+ * @return The matching nodes, sorted by in()
+ */
+[[nodiscard]] std::vector<TagNode*> JoinDescendants(PostingList ancestors, PostingList nodes);
+
+/**
+ * @brief Keep the nodes whose parent is in parents, as in an "A > B" selector
+ * @param parents Nodes sorted by in()
+ * @param nodes Nodes sorted by in()
+ * @return The matching nodes, sorted by in()
+ */
+[[nodiscard]] std::vector<TagNode*> JoinChildren(PostingList parents, PostingList nodes);
+
+}  // namespace arboris
+
+#endif  // SRC_QUERY_STRUCTURAL_JOIN_HPP_
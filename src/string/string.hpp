@@ -8,10 +8,14 @@
 #define SRC_STRING_STRING_HPP_
 
 #include <cctype>
+#include <string>
 #include <string_view>
 
 namespace arboris {
 
+// The scanning functions below dispatch at runtime to the widest vector kernels the CPU supports
+// (see string/string_kernels.hpp). All kernels return exactly the same positions as the scalar ones.
+
 /**
  * @brief Skip whitespace characters in a string_view starting from a given position
  * @param content The string content to process
@@ -20,6 +24,14 @@ namespace arboris {
  */
 std::size_t SkipWhitespace(std::string_view content, std::size_t begin);
 
+/**
+ * @brief Append the words of a text separated by single spaces, dropping leading and trailing whitespace
+ * @param text Text to normalize
+ * @param out String to append to
+ * @return Number of bytes appended, 0 if text is empty or only whitespace
+ */
+std::size_t AppendCollapsedWhitespace(std::string_view text, std::string* out);
+
 /**
  * @brief Extract substring from content using start and end positions
  * @param content The string content to extract from
@@ -56,6 +68,36 @@ std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::st
  */
 std::size_t SkipUntilChar(std::string_view content, std::size_t begin, char target_char);
 
+/**
+ * @brief Find next occurrence of a substring, ignoring ASCII case, starting from given position
+ * @param content The string content to search in
+ * @param begin Starting position for search
+ * @param needle Substring to find
+ * @return Position of the first match, or std::string::npos if not found or needle is empty
+ */
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle);
+
+// Lowercase an ASCII letter; other bytes are returned unchanged
+[[nodiscard]] constexpr char ToLowerAscii(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Compare two strings for equality, ignoring ASCII case
+ * @param lhs First string
+ * @param rhs Second string
+ * @return true if both strings have the same length and match byte by byte after ASCII lowercasing
+ */
+bool EqualsIgnoreAsciiCase(std::string_view lhs, std::string_view rhs);
+
+/**
+ * @brief Order two strings byte by byte after ASCII lowercasing
+ * @param lhs First string
+ * @param rhs Second string
+ * @return Negative, zero or positive like std::string_view::compare
+ */
+int CompareIgnoreAsciiCase(std::string_view lhs, std::string_view rhs) noexcept;
+
 }  // namespace arboris
 
 #endif  // SRC_STRING_STRING_HPP_
@@ -0,0 +1,214 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "string/string_kernels.hpp"
+
+#if defined(ARBORIS_ARCH_X86_64)
+
+#include <immintrin.h>
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+namespace avx2 {
+namespace {
+
+constexpr std::size_t kBlockSize = 32;
+
+// Matches std::isspace in the C locale: ' ', '\t', '\n', '\v', '\f', '\r'
+ARBORIS_TARGET("avx2,bmi")
+inline std::uint32_t WhitespaceMask(__m256i block) {
+  const __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+  const __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+  const __m256i is_space = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '));
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_control, is_space)));
+}
+
+ARBORIS_TARGET("avx2,bmi")
+inline std::uint32_t SetMembershipMask(__m256i block, __m256i lo_table, __m256i hi_table) {
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+  const __m256i lo = _mm256_and_si256(block, nibble_mask);
+  const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble_mask);
+  const __m256i bits = _mm256_and_si256(_mm256_shuffle_epi8(lo_table, lo), _mm256_shuffle_epi8(hi_table, hi));
+  const __m256i misses = _mm256_cmpeq_epi8(bits, _mm256_setzero_si256());
+  return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(misses));
+}
+
+ARBORIS_TARGET("avx2,bmi")
+inline std::uint64_t EqualMask(__m256i low, __m256i high, char c) {
+  const __m256i target = _mm256_set1_epi8(c);
+  const auto low_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, target)));
+  const auto high_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, target)));
+  return low_mask | (static_cast<std::uint64_t>(high_mask) << 32);
+}
+
+ARBORIS_TARGET("avx2,bmi")
+inline StructuralMasks ClassifyBlock(const char* data) {
+  const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+  return {EqualMask(low, high, '<'), EqualMask(low, high, '>'), EqualMask(low, high, '/'),
+          EqualMask(low, high, '"') | EqualMask(low, high, '\''), EqualMask(low, high, '=')};
+}
+
+ARBORIS_TARGET("avx2,bmi")
+inline std::uint32_t CaseFoldedEqualMask(__m256i block, CaseFoldedByte byte) {
+  const __m256i folded = _mm256_or_si256(block, _mm256_set1_epi8(static_cast<char>(byte.fold)));
+  return static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8(static_cast<char>(byte.target)))));
+}
+
+}  // anonymous namespace
+
+ARBORIS_TARGET("avx2,bmi")
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
+  if (begin >= content.length()) {
+    return begin;
+  }
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const std::uint32_t non_whitespace = ~WhitespaceMask(block);
+    if (non_whitespace != 0) {
+      return pos + std::countr_zero(non_whitespace);
+    }
+  }
+  return scalar::SkipWhitespace(content, pos);
+}
+
+ARBORIS_TARGET("avx2,bmi")
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
+  if (begin >= content.length()) {
+    return std::string::npos;
+  }
+
+  const char* data = content.data();
+  const __m256i target = _mm256_set1_epi8(target_char);
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const auto matches = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target)));
+    if (matches != 0) {
+      return pos + std::countr_zero(matches);
+    }
+  }
+  return scalar::FindNextChar(content, pos, target_char);
+}
+
+ARBORIS_TARGET("avx2,bmi")
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars) {
+  if (begin >= content.length() || target_chars.empty()) {
+    return std::string::npos;
+  }
+
+  NibbleTable table;
+  if (!BuildNibbleTable(target_chars, &table)) {
+    return scalar::FindNextAnyChar(content, begin, target_chars);
+  }
+  const __m256i lo_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table.lo)));
+  const __m256i hi_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table.hi)));
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const std::uint32_t matches = SetMembershipMask(block, lo_table, hi_table);
+    if (matches != 0) {
+      return pos + std::countr_zero(matches);
+    }
+  }
+  return scalar::FindNextAnyChar(content, pos, target_chars);
+}
+
+ARBORIS_TARGET("avx2,bmi")
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions) {
+  const char* data = content.data();
+  std::size_t count = 0;
+  std::uint64_t prev_lt = 0;
+  std::size_t pos = 0;
+  for (; pos + kStructuralBlockSize <= content.length(); pos += kStructuralBlockSize) {
+    const StructuralMasks masks = ClassifyBlock(data + pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  if (pos < content.length()) {
+    const StructuralMasks masks = ClassifyStructuralBlock(data + pos, content.length() - pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  return count;
+}
+
+// Candidates must match the first and the last needle byte; only those are compared in full
+ARBORIS_TARGET("avx2,bmi")
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  if (needle.empty() || begin >= content.length() || needle.length() > content.length() - begin) {
+    return std::string::npos;
+  }
+
+  const CaseFoldedByte first = FoldAsciiCase(needle.front());
+  const CaseFoldedByte last = FoldAsciiCase(needle.back());
+  const std::size_t last_offset = needle.length() - 1;
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + last_offset + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + last_offset));
+    std::uint32_t candidates = CaseFoldedEqualMask(head, first) & CaseFoldedEqualMask(tail, last);
+    while (candidates != 0) {
+      const std::size_t candidate = pos + std::countr_zero(candidates);
+      if (EqualsIgnoreAsciiCase(content.substr(candidate, needle.length()), needle)) {
+        return candidate;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  return scalar::FindIgnoreAsciiCase(content, pos, needle);
+}
+
+// Blocks whose only whitespace is single spaces are stored as they are; the others go through the scalar loop
+ARBORIS_TARGET("avx2,bmi")
+std::size_t CollapseWhitespace(std::string_view content, char* out) {
+  const char* data = content.data();
+  std::size_t written = 0;
+  bool in_whitespace = false;
+  std::size_t pos = 0;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const std::uint32_t whitespace = WhitespaceMask(block);
+    const auto spaces =
+        static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '))));
+    const std::uint32_t after_whitespace = (whitespace << 1) | (in_whitespace ? 1U : 0U);
+    if (whitespace == spaces && (whitespace & after_whitespace) == 0) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), block);
+      written += kBlockSize;
+      in_whitespace = (whitespace >> (kBlockSize - 1)) != 0;
+    } else {
+      written += CollapseWhitespaceBlock(data + pos, kBlockSize, &in_whitespace, out + written);
+    }
+  }
+  return written + CollapseWhitespaceBlock(data + pos, content.length() - pos, &in_whitespace, out + written);
+}
+
+}  // namespace avx2
+
+const StringKernels kAvx2StringKernels = {
+    &avx2::SkipWhitespace,
+    &avx2::FindNextChar,
+    &avx2::FindNextAnyChar,
+    &avx2::IndexStructurals,
+    &avx2::FindIgnoreAsciiCase,
+    &avx2::CollapseWhitespace,
+};
+
+}  // namespace arboris
+
+#endif  // defined(ARBORIS_ARCH_X86_64)
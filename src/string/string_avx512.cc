@@ -0,0 +1,206 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "string/string_kernels.hpp"
+
+#if defined(ARBORIS_ARCH_X86_64)
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+namespace avx512 {
+namespace {
+
+constexpr std::size_t kBlockSize = 64;
+
+// Masked loads never fault on the lanes that are switched off, so the tail is handled without a scalar loop
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+inline __mmask64 ValidMask(std::size_t remaining) {
+  return remaining >= kBlockSize ? ~__mmask64{0} : _bzhi_u64(~std::uint64_t{0}, static_cast<unsigned>(remaining));
+}
+
+// Matches std::isspace in the C locale: ' ', '\t', '\n', '\v', '\f', '\r'
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+inline __mmask64 WhitespaceMask(__m512i block) {
+  const __m512i shifted = _mm512_sub_epi8(block, _mm512_set1_epi8('\t'));
+  const __mmask64 is_control = _mm512_cmple_epu8_mask(shifted, _mm512_set1_epi8(4));
+  const __mmask64 is_space = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(' '));
+  return is_control | is_space;
+}
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+inline StructuralMasks ClassifyBlock(__m512i block) {
+  const __mmask64 double_quote = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('"'));
+  const __mmask64 single_quote = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('\''));
+  return {_mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('<')), _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('>')),
+          _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('/')), double_quote | single_quote,
+          _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('='))};
+}
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+inline __mmask64 CaseFoldedEqualMask(__mmask64 valid, __m512i block, CaseFoldedByte byte) {
+  const __m512i folded = _mm512_or_si512(block, _mm512_set1_epi8(static_cast<char>(byte.fold)));
+  return _mm512_mask_cmpeq_epi8_mask(valid, folded, _mm512_set1_epi8(static_cast<char>(byte.target)));
+}
+
+}  // anonymous namespace
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
+  if (begin >= content.length()) {
+    return begin;
+  }
+
+  const char* data = content.data();
+  for (std::size_t pos = begin; pos < content.length(); pos += kBlockSize) {
+    const __mmask64 valid = ValidMask(content.length() - pos);
+    const __m512i block = _mm512_maskz_loadu_epi8(valid, data + pos);
+    const std::uint64_t non_whitespace = ~WhitespaceMask(block) & valid;
+    if (non_whitespace != 0) {
+      return pos + std::countr_zero(non_whitespace);
+    }
+  }
+  return content.length();
+}
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
+  if (begin >= content.length()) {
+    return std::string::npos;
+  }
+
+  const char* data = content.data();
+  const __m512i target = _mm512_set1_epi8(target_char);
+  for (std::size_t pos = begin; pos < content.length(); pos += kBlockSize) {
+    const __mmask64 valid = ValidMask(content.length() - pos);
+    const __m512i block = _mm512_maskz_loadu_epi8(valid, data + pos);
+    const std::uint64_t matches = _mm512_mask_cmpeq_epi8_mask(valid, block, target);
+    if (matches != 0) {
+      return pos + std::countr_zero(matches);
+    }
+  }
+  return std::string::npos;
+}
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars) {
+  if (begin >= content.length() || target_chars.empty()) {
+    return std::string::npos;
+  }
+
+  NibbleTable table;
+  if (!BuildNibbleTable(target_chars, &table)) {
+    return scalar::FindNextAnyChar(content, begin, target_chars);
+  }
+  const __m512i lo_table = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(table.lo)));
+  const __m512i hi_table = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(table.hi)));
+  const __m512i nibble_mask = _mm512_set1_epi8(0x0F);
+
+  const char* data = content.data();
+  for (std::size_t pos = begin; pos < content.length(); pos += kBlockSize) {
+    const __mmask64 valid = ValidMask(content.length() - pos);
+    const __m512i block = _mm512_maskz_loadu_epi8(valid, data + pos);
+    const __m512i lo = _mm512_and_si512(block, nibble_mask);
+    const __m512i hi = _mm512_and_si512(_mm512_srli_epi16(block, 4), nibble_mask);
+    const __m512i bits = _mm512_and_si512(_mm512_shuffle_epi8(lo_table, lo), _mm512_shuffle_epi8(hi_table, hi));
+    const std::uint64_t matches = _mm512_mask_test_epi8_mask(valid, bits, bits);
+    if (matches != 0) {
+      return pos + std::countr_zero(matches);
+    }
+  }
+  return std::string::npos;
+}
+
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions) {
+  const char* data = content.data();
+  std::size_t count = 0;
+  std::uint64_t prev_lt = 0;
+  for (std::size_t pos = 0; pos < content.length(); pos += kStructuralBlockSize) {
+    // Masked-out lanes load as zero, which belongs to no class
+    const __m512i block = _mm512_maskz_loadu_epi8(ValidMask(content.length() - pos), data + pos);
+    count += FlattenStructuralBits(StructuralBits(ClassifyBlock(block), &prev_lt), pos, positions + count);
+  }
+  return count;
+}
+
+// Candidates must match the first and the last needle byte; only those are compared in full.
+// Lane i is valid when a whole needle fits at pos + i, so the head and the tail share one mask.
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  if (needle.empty() || begin >= content.length() || needle.length() > content.length() - begin) {
+    return std::string::npos;
+  }
+
+  const CaseFoldedByte first = FoldAsciiCase(needle.front());
+  const CaseFoldedByte last = FoldAsciiCase(needle.back());
+  const std::size_t last_offset = needle.length() - 1;
+  const std::size_t end = content.length() - last_offset;
+
+  const char* data = content.data();
+  for (std::size_t pos = begin; pos < end; pos += kBlockSize) {
+    const __mmask64 valid = ValidMask(end - pos);
+    const __m512i head = _mm512_maskz_loadu_epi8(valid, data + pos);
+    const __m512i tail = _mm512_maskz_loadu_epi8(valid, data + pos + last_offset);
+    std::uint64_t candidates = CaseFoldedEqualMask(valid, head, first) & CaseFoldedEqualMask(valid, tail, last);
+    while (candidates != 0) {
+      const std::size_t candidate = pos + std::countr_zero(candidates);
+      if (EqualsIgnoreAsciiCase(content.substr(candidate, needle.length()), needle)) {
+        return candidate;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  return std::string::npos;
+}
+
+// Blocks whose only whitespace is single spaces are stored as they are, the tail with a masked store;
+// the others go through the scalar loop
+ARBORIS_TARGET("avx512f,avx512bw,bmi,bmi2")
+std::size_t CollapseWhitespace(std::string_view content, char* out) {
+  const char* data = content.data();
+  std::size_t written = 0;
+  bool in_whitespace = false;
+  for (std::size_t pos = 0; pos < content.length(); pos += kBlockSize) {
+    const std::size_t length = std::min(kBlockSize, content.length() - pos);
+    const __mmask64 valid = ValidMask(length);
+    const __m512i block = _mm512_maskz_loadu_epi8(valid, data + pos);
+    const std::uint64_t whitespace = WhitespaceMask(block) & valid;
+    const std::uint64_t spaces = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(' ')) & valid;
+    const std::uint64_t after_whitespace = (whitespace << 1) | (in_whitespace ? 1U : 0U);
+    if (whitespace == spaces && (whitespace & after_whitespace) == 0) {
+      _mm512_mask_storeu_epi8(out + written, valid, block);
+      written += length;
+      in_whitespace = ((whitespace >> (length - 1)) & 1U) != 0;
+    } else {
+      written += CollapseWhitespaceBlock(data + pos, length, &in_whitespace, out + written);
+    }
+  }
+  return written;
+}
+
+}  // namespace avx512
+
+const StringKernels kAvx512StringKernels = {
+    &avx512::SkipWhitespace,
+    &avx512::FindNextChar,
+    &avx512::FindNextAnyChar,
+    &avx512::IndexStructurals,
+    &avx512::FindIgnoreAsciiCase,
+    &avx512::CollapseWhitespace,
+};
+
+}  // namespace arboris
+
+#endif  // defined(ARBORIS_ARCH_X86_64)
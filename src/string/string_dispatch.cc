@@ -0,0 +1,103 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <atomic>
+#include <cctype>
+#include <string>
+#include <string_view>
+
+#include "string/string.hpp"
+#include "string/string_kernels.hpp"
+
+namespace arboris {
+namespace {
+
+// Resolved lazily instead of at static initialization so that other static initializers may scan strings.
+std::atomic<const StringKernels*> active_kernels{nullptr};
+
+const StringKernels& ResolveActiveKernels() {
+  const StringKernels* kernels = GetStringKernels(DetectSimdLevel());
+  if (kernels == nullptr) {
+    kernels = &kScalarStringKernels;
+  }
+  active_kernels.store(kernels, std::memory_order_release);
+  return *kernels;
+}
+
+}  // anonymous namespace
+
+const StringKernels* GetStringKernels(SimdLevel level) {
+  if (!IsSimdLevelSupported(level)) {
+    return nullptr;
+  }
+
+  switch (level) {
+    case SimdLevel::kScalar:
+      return &kScalarStringKernels;
+#if defined(ARBORIS_ARCH_X86_64)
+    case SimdLevel::kSse42:
+      return &kSse42StringKernels;
+    case SimdLevel::kAvx2:
+      return &kAvx2StringKernels;
+    case SimdLevel::kAvx512:
+      return &kAvx512StringKernels;
+#elif defined(ARBORIS_ARCH_ARM64)
+    case SimdLevel::kNeon:
+      return &kNeonStringKernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const StringKernels& ActiveStringKernels() {
+  const StringKernels* kernels = active_kernels.load(std::memory_order_acquire);
+  if (kernels != nullptr) {
+    return *kernels;
+  }
+  return ResolveActiveKernels();
+}
+
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
+  return ActiveStringKernels().skip_whitespace(content, begin);
+}
+
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
+  return ActiveStringKernels().find_next_char(content, begin, target_char);
+}
+
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars) {
+  return ActiveStringKernels().find_next_any_char(content, begin, target_chars);
+}
+
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  return ActiveStringKernels().find_ignore_ascii_case(content, begin, needle);
+}
+
+std::size_t SkipUntilChar(std::string_view content, std::size_t begin, char target_char) {
+  std::size_t found_pos = FindNextChar(content, begin, target_char);
+  if (found_pos != std::string::npos) {
+    return found_pos;
+  }
+  return std::string::npos;
+}
+
+std::size_t AppendCollapsedWhitespace(std::string_view text, std::string* out) {
+  const std::size_t first = SkipWhitespace(text, 0);
+  std::size_t last = text.length();
+  while (last > first && std::isspace(static_cast<unsigned char>(text[last - 1]))) {
+    --last;
+  }
+  const std::string_view words = text.substr(first, last - first);
+
+  const std::size_t size_before = out->size();
+  out->resize(size_before + words.length());
+  const std::size_t written = ActiveStringKernels().collapse_whitespace(words, out->data() + size_before);
+  out->resize(size_before + written);
+  return written;
+}
+
+}  // namespace arboris
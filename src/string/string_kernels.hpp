@@ -0,0 +1,164 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_STRING_STRING_KERNELS_HPP_
+#define SRC_STRING_STRING_KERNELS_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "utils/simd.hpp"
+
+namespace arboris {
+
+// Table of scanning kernels for one instruction set.
+// The functions behind string.hpp forward to the table selected for the running CPU.
+struct StringKernels {
+  std::size_t (*skip_whitespace)(std::string_view content, std::size_t begin);
+  std::size_t (*find_next_char)(std::string_view content, std::size_t begin, char target_char);
+  std::size_t (*find_next_any_char)(std::string_view content, std::size_t begin, std::string_view target_chars);
+  std::size_t (*index_structurals)(std::string_view content, std::uint32_t* positions);
+  std::size_t (*find_ignore_ascii_case)(std::string_view content, std::size_t begin, std::string_view needle);
+  std::size_t (*collapse_whitespace)(std::string_view content, char* out);
+};
+
+// Reference implementations. Every vector kernel must return exactly what these return.
+namespace scalar {
+
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin);
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char);
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars);
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions);
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle);
+std::size_t CollapseWhitespace(std::string_view content, char* out);
+
+}  // namespace scalar
+
+// Size of the blocks classified by the structural indexer
+inline constexpr std::size_t kStructuralBlockSize = 64;
+
+// Character classes of one block, one bit per byte (bit i is byte i of the block)
+struct StructuralMasks {
+  std::uint64_t lt;
+  std::uint64_t gt;
+  std::uint64_t slash;
+  std::uint64_t quote;
+  std::uint64_t eq;
+};
+
+/**
+ * @brief Classify up to one block of bytes without vector instructions
+ * @param data Start of the block
+ * @param length Number of valid bytes, at most kStructuralBlockSize
+ * @return Character classes of the valid bytes
+ */
+StructuralMasks ClassifyStructuralBlock(const char* data, std::size_t length);
+
+/**
+ * @brief Reduce block classes to the positions the tokenizer stops at
+ * @param masks Character classes of the block
+ * @param prev_lt In/out carry, 1 if the previous block ended with '<'
+ * @return Structural bits: '<', '>', quotes, '=' and the '/' of every "</"
+ */
+inline std::uint64_t StructuralBits(const StructuralMasks& masks, std::uint64_t* prev_lt) {
+  const std::uint64_t after_lt = (masks.lt << 1) | *prev_lt;
+  *prev_lt = masks.lt >> 63;
+  return masks.lt | masks.gt | masks.quote | masks.eq | (masks.slash & after_lt);
+}
+
+/**
+ * @brief Append the positions of all set bits to an output array
+ * @param bits Structural bits of one block
+ * @param base Offset of the block in the content
+ * @param out Output array, must have room for popcount(bits) entries
+ * @return Number of positions written
+ */
+inline std::size_t FlattenStructuralBits(std::uint64_t bits, std::size_t base, std::uint32_t* out) {
+  std::size_t count = 0;
+  while (bits != 0) {
+    out[count++] = static_cast<std::uint32_t>(base + std::countr_zero(bits));
+    bits &= bits - 1;
+  }
+  return count;
+}
+
+// Byte comparison that ignores ASCII case: c matches when (c | fold) == target.
+// Letters fold bit 0x20 so both cases match; any other byte must match exactly.
+struct CaseFoldedByte {
+  std::uint8_t fold;
+  std::uint8_t target;
+};
+
+inline CaseFoldedByte FoldAsciiCase(char c) {
+  const auto byte = static_cast<std::uint8_t>(c);
+  const std::uint8_t lower = byte | 0x20;
+  const std::uint8_t fold = (lower >= 'a' && lower <= 'z') ? 0x20 : 0x00;
+  return {fold, static_cast<std::uint8_t>(byte | fold)};
+}
+
+/**
+ * @brief Copy bytes without vector instructions, writing a single space for every run of whitespace
+ * @param data Bytes to copy
+ * @param length Number of bytes
+ * @param in_whitespace In/out carry, true if the byte before data was whitespace
+ * @param out Output, must have room for length bytes
+ * @return Number of bytes written
+ */
+inline std::size_t CollapseWhitespaceBlock(const char* data, std::size_t length, bool* in_whitespace, char* out) {
+  std::size_t written = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    const char c = data[i];
+    const bool is_whitespace = c == ' ' || (c >= '\t' && c <= '\r');
+    out[written] = is_whitespace ? ' ' : c;
+    written += (is_whitespace && *in_whitespace) ? 0 : 1;
+    *in_whitespace = is_whitespace;
+  }
+  return written;
+}
+
+// Nibble lookup tables for set membership tests with byte shuffles.
+// A byte c belongs to the set when (lo[c & 0x0F] & hi[c >> 4]) != 0.
+struct NibbleTable {
+  alignas(16) std::uint8_t lo[16];
+  alignas(16) std::uint8_t hi[16];
+};
+
+/**
+ * @brief Build nibble lookup tables for a set of characters
+ * @param target_chars Set of characters to encode
+ * @param table Output tables
+ * @return true on success, false if the set contains non-ASCII bytes that the tables cannot represent
+ */
+bool BuildNibbleTable(std::string_view target_chars, NibbleTable* table);
+
+/**
+ * @brief Get the kernel table for a given instruction set
+ * @param level Instruction set of the requested kernels
+ * @return Kernel table, or nullptr if the level is not compiled in or not supported by this CPU
+ */
+const StringKernels* GetStringKernels(SimdLevel level);
+
+/**
+ * @brief Get the kernel table used by the string.hpp functions
+ * @return Kernel table for DetectSimdLevel(), resolved once on first use
+ */
+const StringKernels& ActiveStringKernels();
+
+// Per-ISA tables, defined in string_<isa>.cc. Only referenced on matching architectures.
+extern const StringKernels kScalarStringKernels;
+#if defined(ARBORIS_ARCH_X86_64)
+extern const StringKernels kSse42StringKernels;
+extern const StringKernels kAvx2StringKernels;
+extern const StringKernels kAvx512StringKernels;
+#elif defined(ARBORIS_ARCH_ARM64)
+extern const StringKernels kNeonStringKernels;
+#endif
+
+}  // namespace arboris
+
+#endif  // SRC_STRING_STRING_KERNELS_HPP_
@@ -0,0 +1,214 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "string/string_kernels.hpp"
+
+#if defined(ARBORIS_ARCH_ARM64)
+
+#include <arm_neon.h>
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+namespace neon {
+namespace {
+
+constexpr std::size_t kBlockSize = 16;
+
+// NEON has no movemask; narrowing each 16-bit lane by 4 leaves one nibble per input byte
+inline std::uint64_t NibbleMask(uint8x16_t matches) {
+  const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+inline std::size_t FirstIndex(std::uint64_t nibble_mask) {
+  return static_cast<std::size_t>(std::countr_zero(nibble_mask)) >> 2;
+}
+
+// Matches std::isspace in the C locale: ' ', '\t', '\n', '\v', '\f', '\r'
+inline uint8x16_t WhitespaceMatches(uint8x16_t block) {
+  const uint8x16_t is_control = vcleq_u8(vsubq_u8(block, vdupq_n_u8('\t')), vdupq_n_u8(4));
+  const uint8x16_t is_space = vceqq_u8(block, vdupq_n_u8(' '));
+  return vorrq_u8(is_control, is_space);
+}
+
+// One bit per byte over four registers, by weighting each lane and folding with pairwise adds
+inline std::uint64_t BitMask64(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+  static constexpr std::uint8_t kWeights[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                                0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+  const uint8x16_t weights = vld1q_u8(kWeights);
+  uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+  const uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+  sum0 = vpaddq_u8(sum0, sum1);
+  sum0 = vpaddq_u8(sum0, sum0);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+inline std::uint64_t EqualMask(const uint8x16_t (&blocks)[4], char c) {
+  const uint8x16_t target = vdupq_n_u8(static_cast<std::uint8_t>(c));
+  return BitMask64(vceqq_u8(blocks[0], target), vceqq_u8(blocks[1], target), vceqq_u8(blocks[2], target),
+                   vceqq_u8(blocks[3], target));
+}
+
+inline StructuralMasks ClassifyBlock(const std::uint8_t* data) {
+  const uint8x16_t blocks[4] = {vld1q_u8(data), vld1q_u8(data + 16), vld1q_u8(data + 32), vld1q_u8(data + 48)};
+  return {EqualMask(blocks, '<'), EqualMask(blocks, '>'), EqualMask(blocks, '/'),
+          EqualMask(blocks, '"') | EqualMask(blocks, '\''), EqualMask(blocks, '=')};
+}
+
+inline uint8x16_t CaseFoldedMatches(uint8x16_t block, CaseFoldedByte byte) {
+  return vceqq_u8(vorrq_u8(block, vdupq_n_u8(byte.fold)), vdupq_n_u8(byte.target));
+}
+
+}  // anonymous namespace
+
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
+  if (begin >= content.length()) {
+    return begin;
+  }
+
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const uint8x16_t block = vld1q_u8(data + pos);
+    const std::uint64_t non_whitespace = NibbleMask(vmvnq_u8(WhitespaceMatches(block)));
+    if (non_whitespace != 0) {
+      return pos + FirstIndex(non_whitespace);
+    }
+  }
+  return scalar::SkipWhitespace(content, pos);
+}
+
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
+  if (begin >= content.length()) {
+    return std::string::npos;
+  }
+
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  const uint8x16_t target = vdupq_n_u8(static_cast<std::uint8_t>(target_char));
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const std::uint64_t matches = NibbleMask(vceqq_u8(vld1q_u8(data + pos), target));
+    if (matches != 0) {
+      return pos + FirstIndex(matches);
+    }
+  }
+  return scalar::FindNextChar(content, pos, target_char);
+}
+
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars) {
+  if (begin >= content.length() || target_chars.empty()) {
+    return std::string::npos;
+  }
+
+  NibbleTable table;
+  if (!BuildNibbleTable(target_chars, &table)) {
+    return scalar::FindNextAnyChar(content, begin, target_chars);
+  }
+  const uint8x16_t lo_table = vld1q_u8(table.lo);
+  const uint8x16_t hi_table = vld1q_u8(table.hi);
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0F);
+
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const uint8x16_t block = vld1q_u8(data + pos);
+    const uint8x16_t lo = vandq_u8(block, nibble_mask);
+    const uint8x16_t hi = vshrq_n_u8(block, 4);
+    const uint8x16_t bits = vandq_u8(vqtbl1q_u8(lo_table, lo), vqtbl1q_u8(hi_table, hi));
+    const std::uint64_t matches = NibbleMask(vtstq_u8(bits, bits));
+    if (matches != 0) {
+      return pos + FirstIndex(matches);
+    }
+  }
+  return scalar::FindNextAnyChar(content, pos, target_chars);
+}
+
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions) {
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  std::size_t count = 0;
+  std::uint64_t prev_lt = 0;
+  std::size_t pos = 0;
+  for (; pos + kStructuralBlockSize <= content.length(); pos += kStructuralBlockSize) {
+    const StructuralMasks masks = ClassifyBlock(data + pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  if (pos < content.length()) {
+    const StructuralMasks masks = ClassifyStructuralBlock(content.data() + pos, content.length() - pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  return count;
+}
+
+// Candidates must match the first and the last needle byte; only those are compared in full
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  if (needle.empty() || begin >= content.length() || needle.length() > content.length() - begin) {
+    return std::string::npos;
+  }
+
+  const CaseFoldedByte first = FoldAsciiCase(needle.front());
+  const CaseFoldedByte last = FoldAsciiCase(needle.back());
+  const std::size_t last_offset = needle.length() - 1;
+
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  std::size_t pos = begin;
+  for (; pos + last_offset + kBlockSize <= content.length(); pos += kBlockSize) {
+    const uint8x16_t head = CaseFoldedMatches(vld1q_u8(data + pos), first);
+    const uint8x16_t tail = CaseFoldedMatches(vld1q_u8(data + pos + last_offset), last);
+    std::uint64_t candidates = NibbleMask(vandq_u8(head, tail));
+    while (candidates != 0) {
+      const std::size_t index = FirstIndex(candidates);
+      if (EqualsIgnoreAsciiCase(content.substr(pos + index, needle.length()), needle)) {
+        return pos + index;
+      }
+      candidates &= ~(std::uint64_t{0xF} << (4 * index));
+    }
+  }
+  return scalar::FindIgnoreAsciiCase(content, pos, needle);
+}
+
+// Blocks whose only whitespace is single spaces are stored as they are; the others go through the scalar loop
+std::size_t CollapseWhitespace(std::string_view content, char* out) {
+  const auto* data = reinterpret_cast<const std::uint8_t*>(content.data());
+  std::size_t written = 0;
+  bool in_whitespace = false;
+  std::size_t pos = 0;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const uint8x16_t block = vld1q_u8(data + pos);
+    const uint8x16_t whitespace = WhitespaceMatches(block);
+    const uint8x16_t not_space = vbicq_u8(whitespace, vceqq_u8(block, vdupq_n_u8(' ')));
+    // Lane i holds the previous byte's class: the carry for lane 0, byte i - 1 otherwise
+    const uint8x16_t after_whitespace = vextq_u8(vdupq_n_u8(in_whitespace ? 0xFF : 0), whitespace, 15);
+    if (vmaxvq_u8(vorrq_u8(not_space, vandq_u8(whitespace, after_whitespace))) == 0) {
+      vst1q_u8(reinterpret_cast<std::uint8_t*>(out + written), block);
+      written += kBlockSize;
+      in_whitespace = vgetq_lane_u8(whitespace, 15) != 0;
+    } else {
+      written += CollapseWhitespaceBlock(content.data() + pos, kBlockSize, &in_whitespace, out + written);
+    }
+  }
+  return written + CollapseWhitespaceBlock(content.data() + pos, content.length() - pos, &in_whitespace, out + written);
+}
+
+}  // namespace neon
+
+const StringKernels kNeonStringKernels = {
+    &neon::SkipWhitespace,
+    &neon::FindNextChar,
+    &neon::FindNextAnyChar,
+    &neon::IndexStructurals,
+    &neon::FindIgnoreAsciiCase,
+    &neon::CollapseWhitespace,
+};
+
+}  // namespace arboris
+
+#endif  // defined(ARBORIS_ARCH_ARM64)
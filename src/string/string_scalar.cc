@@ -6,9 +6,12 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include "string/string.hpp"
+#include "string/string_kernels.hpp"
 
 namespace arboris {
 namespace {
@@ -19,6 +22,8 @@ inline bool IsValidPosition(std::string_view content, std::size_t pos) {
 
 }  // anonymous namespace
 
+namespace scalar {
+
 std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
   while (IsValidPosition(content, begin) && std::isspace(content[begin])) {
     ++begin;
@@ -26,15 +31,6 @@ std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
   return begin;
 }
 
-std::string_view ExtractSubstring(std::string_view content, std::size_t start, std::size_t end) {
-  if (start >= content.length() || start >= end) {
-    return std::string_view{};
-  }
-
-  std::size_t actual_end = std::min(end, content.length());
-  return content.substr(start, actual_end - start);
-}
-
 std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
   for (std::size_t i = begin; i < content.length(); i++) {
     if (content[i] == target_char) {
@@ -55,12 +51,128 @@ std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::st
   return std::string::npos;
 }
 
-std::size_t SkipUntilChar(std::string_view content, std::size_t begin, char target_char) {
-  std::size_t found_pos = FindNextChar(content, begin, target_char);
-  if (found_pos != std::string::npos) {
-    return found_pos;
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions) {
+  std::size_t count = 0;
+  std::uint64_t prev_lt = 0;
+  for (std::size_t pos = 0; pos < content.length(); pos += kStructuralBlockSize) {
+    const std::size_t length = std::min(kStructuralBlockSize, content.length() - pos);
+    const StructuralMasks masks = ClassifyStructuralBlock(content.data() + pos, length);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  return count;
+}
+
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  if (needle.empty() || begin >= content.length() || needle.length() > content.length() - begin) {
+    return std::string::npos;
+  }
+
+  for (std::size_t i = begin; i + needle.length() <= content.length(); i++) {
+    if (EqualsIgnoreAsciiCase(content.substr(i, needle.length()), needle)) {
+      return i;
+    }
   }
   return std::string::npos;
 }
 
+std::size_t CollapseWhitespace(std::string_view content, char* out) {
+  bool in_whitespace = false;
+  return CollapseWhitespaceBlock(content.data(), content.length(), &in_whitespace, out);
+}
+
+}  // namespace scalar
+
+StructuralMasks ClassifyStructuralBlock(const char* data, std::size_t length) {
+  StructuralMasks masks{};
+  for (std::size_t i = 0; i < length; ++i) {
+    const std::uint64_t bit = std::uint64_t{1} << i;
+    switch (data[i]) {
+      case '<':
+        masks.lt |= bit;
+        break;
+      case '>':
+        masks.gt |= bit;
+        break;
+      case '/':
+        masks.slash |= bit;
+        break;
+      case '"':
+      case '\'':
+        masks.quote |= bit;
+        break;
+      case '=':
+        masks.eq |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+  return masks;
+}
+
+bool BuildNibbleTable(std::string_view target_chars, NibbleTable* table) {
+  std::fill(std::begin(table->lo), std::end(table->lo), 0);
+  for (std::size_t i = 0; i < 16; ++i) {
+    // High nibbles 8..15 are non-ASCII and never match
+    table->hi[i] = i < 8 ? static_cast<std::uint8_t>(1U << i) : 0;
+  }
+
+  for (const char kTarget : target_chars) {
+    const auto byte = static_cast<std::uint8_t>(kTarget);
+    if (byte >= 0x80) {
+      return false;
+    }
+    table->lo[byte & 0x0F] |= static_cast<std::uint8_t>(1U << (byte >> 4));
+  }
+  return true;
+}
+
+const StringKernels kScalarStringKernels = {
+    &scalar::SkipWhitespace,
+    &scalar::FindNextChar,
+    &scalar::FindNextAnyChar,
+    &scalar::IndexStructurals,
+    &scalar::FindIgnoreAsciiCase,
+    &scalar::CollapseWhitespace,
+};
+
+std::string_view ExtractSubstring(std::string_view content, std::size_t start, std::size_t end) {
+  if (start >= content.length() || start >= end) {
+    return std::string_view{};
+  }
+
+  std::size_t actual_end = std::min(end, content.length());
+  return content.substr(start, actual_end - start);
+}
+
+bool EqualsIgnoreAsciiCase(std::string_view lhs, std::string_view rhs) {
+  if (lhs.length() != rhs.length()) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < lhs.length(); ++i) {
+    char a = lhs[i];
+    char b = rhs[i];
+    if (a == b) {
+      continue;
+    }
+    if (ToLowerAscii(a) != ToLowerAscii(b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int CompareIgnoreAsciiCase(std::string_view lhs, std::string_view rhs) noexcept {
+  const std::size_t length = std::min(lhs.size(), rhs.size());
+  for (std::size_t i = 0; i < length; ++i) {
+    const auto left = static_cast<unsigned char>(ToLowerAscii(lhs[i]));
+    const auto right = static_cast<unsigned char>(ToLowerAscii(rhs[i]));
+    if (left != right) {
+      return left < right ? -1 : 1;
+    }
+  }
+  return lhs.size() == rhs.size() ? 0 : (lhs.size() < rhs.size() ? -1 : 1);
+}
+
 }  // namespace arboris
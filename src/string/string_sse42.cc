@@ -0,0 +1,212 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "string/string_kernels.hpp"
+
+#if defined(ARBORIS_ARCH_X86_64)
+
+#include <immintrin.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+namespace sse42 {
+namespace {
+
+constexpr std::size_t kBlockSize = 16;
+constexpr int kEqualAnyMode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+
+// Matches std::isspace in the C locale: ' ', '\t', '\n', '\v', '\f', '\r'
+ARBORIS_TARGET("sse4.2")
+inline unsigned WhitespaceMask(__m128i block) {
+  const __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+  const __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+  const __m128i is_space = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+  return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(is_control, is_space)));
+}
+
+ARBORIS_TARGET("sse4.2")
+inline std::uint64_t EqualMask(const __m128i (&blocks)[4], char c) {
+  const __m128i target = _mm_set1_epi8(c);
+  std::uint64_t mask = 0;
+  for (int i = 0; i < 4; ++i) {
+    const auto lane = static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(blocks[i], target)));
+    mask |= lane << (16 * i);
+  }
+  return mask;
+}
+
+ARBORIS_TARGET("sse4.2")
+inline StructuralMasks ClassifyBlock(const char* data) {
+  __m128i blocks[4];
+  for (int i = 0; i < 4; ++i) {
+    blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+  }
+  return {EqualMask(blocks, '<'), EqualMask(blocks, '>'), EqualMask(blocks, '/'),
+          EqualMask(blocks, '"') | EqualMask(blocks, '\''), EqualMask(blocks, '=')};
+}
+
+ARBORIS_TARGET("sse4.2")
+inline unsigned CaseFoldedEqualMask(__m128i block, CaseFoldedByte byte) {
+  const __m128i folded = _mm_or_si128(block, _mm_set1_epi8(static_cast<char>(byte.fold)));
+  const __m128i target = _mm_set1_epi8(static_cast<char>(byte.target));
+  return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(folded, target)));
+}
+
+}  // anonymous namespace
+
+ARBORIS_TARGET("sse4.2")
+std::size_t SkipWhitespace(std::string_view content, std::size_t begin) {
+  if (begin >= content.length()) {
+    return begin;
+  }
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const unsigned non_whitespace = ~WhitespaceMask(block) & 0xFFFFU;
+    if (non_whitespace != 0) {
+      return pos + std::countr_zero(non_whitespace);
+    }
+  }
+  return scalar::SkipWhitespace(content, pos);
+}
+
+ARBORIS_TARGET("sse4.2")
+std::size_t FindNextChar(std::string_view content, std::size_t begin, char target_char) {
+  if (begin >= content.length()) {
+    return std::string::npos;
+  }
+
+  const char* data = content.data();
+  const __m128i target = _mm_set1_epi8(target_char);
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const auto matches = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+    if (matches != 0) {
+      return pos + std::countr_zero(matches);
+    }
+  }
+  return scalar::FindNextChar(content, pos, target_char);
+}
+
+ARBORIS_TARGET("sse4.2")
+std::size_t FindNextAnyChar(std::string_view content, std::size_t begin, std::string_view target_chars) {
+  if (begin >= content.length() || target_chars.empty()) {
+    return std::string::npos;
+  }
+  // PCMPESTRI compares against at most 16 set members
+  if (target_chars.length() > kBlockSize) {
+    return scalar::FindNextAnyChar(content, begin, target_chars);
+  }
+
+  alignas(16) char set_bytes[kBlockSize] = {};
+  std::memcpy(set_bytes, target_chars.data(), target_chars.length());
+  const __m128i set = _mm_load_si128(reinterpret_cast<const __m128i*>(set_bytes));
+  const int set_length = static_cast<int>(target_chars.length());
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const int index = _mm_cmpestri(set, set_length, block, static_cast<int>(kBlockSize), kEqualAnyMode);
+    if (index < static_cast<int>(kBlockSize)) {
+      return pos + index;
+    }
+  }
+  return scalar::FindNextAnyChar(content, pos, target_chars);
+}
+
+ARBORIS_TARGET("sse4.2")
+std::size_t IndexStructurals(std::string_view content, std::uint32_t* positions) {
+  const char* data = content.data();
+  std::size_t count = 0;
+  std::uint64_t prev_lt = 0;
+  std::size_t pos = 0;
+  for (; pos + kStructuralBlockSize <= content.length(); pos += kStructuralBlockSize) {
+    const StructuralMasks masks = ClassifyBlock(data + pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  if (pos < content.length()) {
+    const StructuralMasks masks = ClassifyStructuralBlock(data + pos, content.length() - pos);
+    count += FlattenStructuralBits(StructuralBits(masks, &prev_lt), pos, positions + count);
+  }
+  return count;
+}
+
+// Candidates must match the first and the last needle byte; only those are compared in full
+ARBORIS_TARGET("sse4.2")
+std::size_t FindIgnoreAsciiCase(std::string_view content, std::size_t begin, std::string_view needle) {
+  if (needle.empty() || begin >= content.length() || needle.length() > content.length() - begin) {
+    return std::string::npos;
+  }
+
+  const CaseFoldedByte first = FoldAsciiCase(needle.front());
+  const CaseFoldedByte last = FoldAsciiCase(needle.back());
+  const std::size_t last_offset = needle.length() - 1;
+
+  const char* data = content.data();
+  std::size_t pos = begin;
+  for (; pos + last_offset + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + last_offset));
+    unsigned candidates = CaseFoldedEqualMask(head, first) & CaseFoldedEqualMask(tail, last);
+    while (candidates != 0) {
+      const std::size_t candidate = pos + std::countr_zero(candidates);
+      if (EqualsIgnoreAsciiCase(content.substr(candidate, needle.length()), needle)) {
+        return candidate;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  return scalar::FindIgnoreAsciiCase(content, pos, needle);
+}
+
+// Blocks whose only whitespace is single spaces are stored as they are; the others go through the scalar loop
+ARBORIS_TARGET("sse4.2")
+std::size_t CollapseWhitespace(std::string_view content, char* out) {
+  const char* data = content.data();
+  std::size_t written = 0;
+  bool in_whitespace = false;
+  std::size_t pos = 0;
+  for (; pos + kBlockSize <= content.length(); pos += kBlockSize) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const unsigned whitespace = WhitespaceMask(block);
+    const auto spaces = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(' '))));
+    const unsigned after_whitespace = (whitespace << 1) | (in_whitespace ? 1U : 0U);
+    if (whitespace == spaces && (whitespace & after_whitespace) == 0) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written), block);
+      written += kBlockSize;
+      in_whitespace = (whitespace >> (kBlockSize - 1)) != 0;
+    } else {
+      written += CollapseWhitespaceBlock(data + pos, kBlockSize, &in_whitespace, out + written);
+    }
+  }
+  return written + CollapseWhitespaceBlock(data + pos, content.length() - pos, &in_whitespace, out + written);
+}
+
+}  // namespace sse42
+
+const StringKernels kSse42StringKernels = {
+    &sse42::SkipWhitespace,
+    &sse42::FindNextChar,
+    &sse42::FindNextAnyChar,
+    &sse42::IndexStructurals,
+    &sse42::FindIgnoreAsciiCase,
+    &sse42::CollapseWhitespace,
+};
+
+}  // namespace arboris
+
+#endif  // defined(ARBORIS_ARCH_X86_64)
@@ -0,0 +1,59 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "string/structural_index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "string/string_kernels.hpp"
+#include "utils/assertion.hpp"
+
+namespace arboris {
+
+void StructuralIndex::Build(std::string_view content) {
+  ARBORIS_ASSERT(content.length() <= std::numeric_limits<std::uint32_t>::max(),
+                 "content is too large for 32-bit positions. got " << content.length());
+
+  // Every byte may be structural. The buffer is left uninitialized so that pages are only touched when written.
+  if (capacity_ < content.length()) {
+    positions_ = std::make_unique_for_overwrite<std::uint32_t[]>(content.length());
+    capacity_ = content.length();
+  }
+  size_ = ActiveStringKernels().index_structurals(content, positions_.get());
+}
+
+void StructuralIndex::Extend(std::string_view content, std::size_t indexed) {
+  ARBORIS_ASSERT(content.length() <= std::numeric_limits<std::uint32_t>::max(),
+                 "content is too large for 32-bit positions. got " << content.length());
+  ARBORIS_ASSERT(indexed <= content.length(), "indexed is past the content. got " << indexed);
+
+  if (capacity_ < content.length()) {
+    const std::size_t capacity = std::max(content.length(), 2 * capacity_);
+    auto positions = std::make_unique_for_overwrite<std::uint32_t[]>(capacity);
+    std::copy(begin(), end(), positions.get());
+    positions_ = std::move(positions);
+    capacity_ = capacity;
+  }
+
+  // The '/' of a "</" split by the old end is not found in the new bytes alone
+  if (indexed > 0 && indexed < content.length() && content[indexed - 1] == '<' && content[indexed] == '/') {
+    positions_[size_++] = static_cast<std::uint32_t>(indexed);
+  }
+
+  std::uint32_t* first = positions_.get() + size_;
+  const std::size_t count = ActiveStringKernels().index_structurals(content.substr(indexed), first);
+  for (std::uint32_t* position = first; position != first + count; ++position) {
+    *position += static_cast<std::uint32_t>(indexed);
+  }
+  size_ += count;
+}
+
+}  // namespace arboris
@@ -0,0 +1,67 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_STRING_STRUCTURAL_INDEX_HPP_
+#define SRC_STRING_STRUCTURAL_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace arboris {
+
+// Stage 1 of tokenization: the sorted positions of every '<', '>', quote, '=' and the '/' of every "</" in a
+// document, found 64 bytes at a time by the vector kernels. Stage 2 walks these positions instead of
+// rescanning the bytes between them.
+class StructuralIndex {
+ public:
+  StructuralIndex() = default;
+  StructuralIndex(const StructuralIndex&) = delete;
+  StructuralIndex& operator=(const StructuralIndex&) = delete;
+  StructuralIndex(StructuralIndex&&) = default;
+  StructuralIndex& operator=(StructuralIndex&&) = default;
+  ~StructuralIndex() = default;
+
+  /**
+   * @brief Index a document, replacing the previous contents. The buffer is reused when large enough
+   * @param content Document to index, at most 4 GiB
+   */
+  void Build(std::string_view content);
+
+  /**
+   * @brief Index the bytes appended to the document since it was indexed, keeping the positions found so far.
+   *        Each byte is indexed once however the document grows; the buffer grows geometrically.
+   * @param content The indexed document followed by new bytes, at most 4 GiB
+   * @param indexed Length of the document that is indexed already
+   */
+  void Extend(std::string_view content, std::size_t indexed);
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] std::uint32_t operator[](std::size_t i) const noexcept {
+    return positions_[i];
+  }
+
+  [[nodiscard]] const std::uint32_t* begin() const noexcept {
+    return positions_.get();
+  }
+
+  [[nodiscard]] const std::uint32_t* end() const noexcept {
+    return positions_.get() + size_;
+  }
+
+ private:
+  std::unique_ptr<std::uint32_t[]> positions_;
+  std::size_t capacity_{0};
+  std::size_t size_{0};
+};
+
+}  // namespace arboris
+
+#endif  // SRC_STRING_STRUCTURAL_INDEX_HPP_
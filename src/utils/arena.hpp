@@ -0,0 +1,184 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_UTILS_ARENA_HPP_
+#define SRC_UTILS_ARENA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "utils/assertion.hpp"
+
+namespace arboris {
+
+// Monotonic bump allocator. Objects are never freed one by one: destructors do not run, so only trivially
+// destructible types can be placed in it, and Reset() releases everything at once while keeping the blocks
+// for the next document. Allocations never move.
+class Arena {
+ public:
+  static constexpr std::size_t kDefaultBlockSize = 64 << 10;
+  static constexpr std::size_t kHugePageSize = 2 << 20;
+
+  // With huge_pages, blocks of at least kHugePageSize are aligned to it and advised as transparent huge pages
+  explicit Arena(std::size_t block_size = kDefaultBlockSize, bool huge_pages = false)
+      : block_size_(block_size), huge_pages_(huge_pages) {
+    ARBORIS_ASSERT(block_size > 0, "block_size must be greater than 0");
+  }
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena(Arena&&) = delete;
+  Arena& operator=(Arena&&) = delete;
+  ~Arena() = default;
+
+  /**
+   * @brief Allocate uninitialized memory
+   * @param size Number of bytes
+   * @param alignment Power of two alignment of the returned pointer
+   * @return Pointer valid until Reset() or the destruction of the arena
+   */
+  [[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    ARBORIS_ASSERT((alignment & (alignment - 1)) == 0, "alignment must be a power of two. got " << alignment);
+    std::size_t begin = alignUp(cursor_, alignment);
+    if (begin + size > limit_) {
+      nextBlock(size + alignment);
+      begin = alignUp(cursor_, alignment);
+    }
+    cursor_ = begin + size;
+    bytes_used_ += size;
+    return reinterpret_cast<void*>(begin);
+  }
+
+  // Make the next size bytes of allocations with alignment 1 contiguous, starting at cursor()
+  void Reserve(std::size_t size) {
+    if (limit_ - cursor_ < size) {
+      nextBlock(size);
+    }
+  }
+
+  // Where the next allocation with alignment 1 starts if it fits in the current block
+  [[nodiscard]] const void* cursor() const noexcept {
+    return reinterpret_cast<const void*>(cursor_);
+  }
+
+  template <typename T, typename... Args>
+  [[nodiscard]] T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+    return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // Copy of items in the arena
+  template <typename T>
+  [[nodiscard]] std::span<T> NewArray(std::span<const T> items) {
+    static_assert(std::is_trivially_copyable_v<T>, "Arena arrays are copied bytewise");
+    if (items.empty()) {
+      return {};
+    }
+    T* data = static_cast<T*>(Allocate(items.size_bytes(), alignof(T)));
+    std::uninitialized_copy(items.begin(), items.end(), data);
+    return {data, items.size()};
+  }
+
+  // Release every allocation in O(1). Blocks are kept and reused by later allocations.
+  void Reset() noexcept {
+    block_index_ = 0;
+    cursor_ = blocks_.empty() ? 0 : blocks_[0].begin();
+    limit_ = blocks_.empty() ? 0 : blocks_[0].end();
+    bytes_used_ = 0;
+  }
+
+  // Bytes handed out since construction or the last Reset(), without alignment padding
+  [[nodiscard]] std::size_t bytes_used() const noexcept {
+    return bytes_used_;
+  }
+
+  // Bytes held in blocks, used or not
+  [[nodiscard]] std::size_t bytes_reserved() const noexcept {
+    return bytes_reserved_;
+  }
+
+ private:
+  struct BlockDeleter {
+    std::size_t alignment;
+
+    void operator()(std::byte* data) const noexcept {
+      ::operator delete[](data, std::align_val_t{alignment});
+    }
+  };
+
+  struct Block {
+    std::unique_ptr<std::byte[], BlockDeleter> data;
+    std::size_t size;
+
+    [[nodiscard]] std::uintptr_t begin() const noexcept {
+      return reinterpret_cast<std::uintptr_t>(data.get());
+    }
+
+    [[nodiscard]] std::uintptr_t end() const noexcept {
+      return begin() + size;
+    }
+  };
+
+  static constexpr std::uintptr_t alignUp(std::uintptr_t pos, std::size_t alignment) noexcept {
+    return (pos + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+  }
+
+  // Continue in the next kept block that has min_size bytes, or in a new one
+  void nextBlock(std::size_t min_size) {
+    std::size_t next = blocks_.empty() ? 0 : block_index_ + 1;
+    while (next < blocks_.size() && blocks_[next].size < min_size) {
+      ++next;
+    }
+    if (next == blocks_.size()) {
+      blocks_.push_back(newBlock(std::max(block_size_, min_size)));
+      bytes_reserved_ += blocks_.back().size;
+    }
+
+    block_index_ = next;
+    cursor_ = blocks_[next].begin();
+    limit_ = blocks_[next].end();
+  }
+
+  Block newBlock(std::size_t size) const {
+    const bool huge = huge_pages_ && size >= kHugePageSize;
+    const std::size_t alignment = huge ? kHugePageSize : alignof(std::max_align_t);
+    if (huge) {
+      size = alignUp(size, kHugePageSize);
+    }
+
+    auto* data = new (std::align_val_t{alignment}) std::byte[size];
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge) {
+      // Only a hint: without transparent huge page support the block stays in regular pages
+      madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+    return {std::unique_ptr<std::byte[], BlockDeleter>(data, BlockDeleter{alignment}), size};
+  }
+
+  const std::size_t block_size_;
+  const bool huge_pages_;
+  std::vector<Block> blocks_;
+  std::size_t block_index_{0};
+  std::uintptr_t cursor_{0};
+  std::uintptr_t limit_{0};
+  std::size_t bytes_used_{0};
+  std::size_t bytes_reserved_{0};
+};
+
+}  // namespace arboris
+
+#endif  // SRC_UTILS_ARENA_HPP_
@@ -0,0 +1,115 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_UTILS_CLASS_LIST_HPP_
+#define SRC_UTILS_CLASS_LIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace arboris {
+
+// The whitespace-separated names of a class attribute.
+// Holds a view of the raw attribute value and splits it on iteration, so it never allocates.
+class ClassList {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = std::string_view;
+
+    Iterator() = default;
+    // pos must not exceed raw.size()
+    Iterator(std::string_view raw, std::size_t pos) : raw_(raw) {
+      seek(pos);
+    }
+
+    reference operator*() const noexcept {
+      return current_;
+    }
+
+    Iterator& operator++() {
+      seek(next_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const Iterator& other) const noexcept {
+      return current_.data() == other.current_.data() && current_.size() == other.current_.size();
+    }
+
+   private:
+    static constexpr bool isSpace(char c) noexcept {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+    }
+
+    void seek(std::size_t pos) {
+      while (pos < raw_.size() && isSpace(raw_[pos])) {
+        ++pos;
+      }
+      std::size_t end = pos;
+      while (end < raw_.size() && !isSpace(raw_[end])) {
+        ++end;
+      }
+      // The end iterator is the empty view at the end of the raw value
+      current_ = raw_.substr(pos, end - pos);
+      next_ = end;
+    }
+
+    std::string_view raw_;
+    std::string_view current_;
+    std::size_t next_{0};
+  };
+
+  ClassList() = default;
+  explicit ClassList(std::string_view raw) : raw_(raw) {}
+
+  [[nodiscard]] Iterator begin() const {
+    return {raw_, 0};
+  }
+
+  [[nodiscard]] Iterator end() const {
+    return {raw_, raw_.size()};
+  }
+
+  [[nodiscard]] bool empty() const {
+    return begin() == end();
+  }
+
+  [[nodiscard]] std::string_view raw() const noexcept {
+    return raw_;
+  }
+
+  /**
+   * @brief Check whether a class name is in the list (case-sensitive, as in standards mode)
+   * @param class_name Class name to look for
+   * @return true if one of the names equals class_name
+   */
+  [[nodiscard]] bool Contains(std::string_view class_name) const {
+    for (std::string_view name : *this) {
+      if (name == class_name) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::string_view raw_;
+};
+
+}  // namespace arboris
+
+#endif  // SRC_UTILS_CLASS_LIST_HPP_
@@ -0,0 +1,29 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "utils/html_tokens.hpp"
+
+#include <span>
+#include <string_view>
+
+#include "string/string.hpp"
+
+namespace arboris {
+
+const HtmlAttribute* FindAttribute(std::span<const HtmlAttribute> attributes, std::string_view name) {
+  for (const auto& attribute : attributes) {
+    if (EqualsIgnoreAsciiCase(attribute.name, name)) {
+      return &attribute;
+    }
+  }
+  return nullptr;
+}
+
+const HtmlAttribute* HtmlToken::FindAttribute(std::string_view name) const {
+  return arboris::FindAttribute(attributes, name);
+}
+
+}  // namespace arboris
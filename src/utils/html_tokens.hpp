@@ -7,11 +7,12 @@
 #ifndef SRC_UTILS_HTML_TOKENS_HPP_
 #define SRC_UTILS_HTML_TOKENS_HPP_
 
-#include <string>
+#include <cstdint>
+#include <span>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
+#include "utils/class_list.hpp"
 #include "utils/tag.hpp"
 #include "utils/tokens.hpp"
 
@@ -19,14 +20,36 @@ namespace arboris {
 
 struct BaseHtmlToken : public BaseToken {};
 
+// Attribute of an open tag. Name and value are views into the source document.
+// Boolean attributes (e.g. <input disabled>) have an empty value.
+struct HtmlAttribute {
+  std::string_view name;
+  std::string_view value;
+};
+
+/**
+ * @brief Find an attribute by name, ignoring ASCII case
+ * @param attributes Attributes of a tag
+ * @param name Attribute name to look for
+ * @return Pointer to the attribute, or nullptr if there is none with that name
+ */
+[[nodiscard]] const HtmlAttribute* FindAttribute(std::span<const HtmlAttribute> attributes, std::string_view name);
+
 struct HtmlToken : public BaseHtmlToken {
   Tag tag = Tag::kUnknown;
   bool is_void_tag = false;
 
-  // TODO(team): Consider using string_views with an external string pool
-  std::unordered_map<std::string, std::string> attributes;
-  std::vector<std::string> classes;
-  std::string id;
+  // Attributes in source order, without duplicates (the first occurrence wins)
+  std::vector<HtmlAttribute> attributes;
+  ClassList classes;
+  std::string_view id;
+
+  /**
+   * @brief Find an attribute by name, ignoring ASCII case
+   * @param name Attribute name to look for
+   * @return Pointer to the attribute, or nullptr if the tag has none with that name
+   */
+  [[nodiscard]] const HtmlAttribute* FindAttribute(std::string_view name) const;
 };
 
 struct HtmlTextToken : public BaseHtmlToken {
@@ -37,6 +60,21 @@ struct HtmlCloseToken : public BaseHtmlToken {
   Tag tag = Tag::kUnknown;
 };
 
+// Markup that is neither an element nor text
+enum class HtmlMarkupKind : std::uint8_t {
+  kComment,                // <!-- ... -->, and bogus comments such as <!foo>
+  kDoctype,                // <!DOCTYPE ...>
+  kCdata,                  // <![CDATA[ ... ]]>
+  kProcessingInstruction,  // <? ... >
+};
+
+// Comment, doctype, CDATA section or processing instruction.
+// content is a view into the source document without the delimiters, e.g. "html" for <!DOCTYPE html>.
+struct HtmlMarkupToken : public BaseHtmlToken {
+  HtmlMarkupKind kind = HtmlMarkupKind::kComment;
+  std::string_view content;
+};
+
 }  // namespace arboris
 
 #endif  // SRC_UTILS_HTML_TOKENS_HPP_
@@ -0,0 +1,87 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "utils/simd.hpp"
+
+#include <initializer_list>
+
+#if defined(ARBORIS_ARCH_X86_64) && defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace arboris {
+namespace {
+
+#if defined(ARBORIS_ARCH_X86_64) && defined(_MSC_VER) && !defined(__clang__)
+struct X86Features {
+  bool sse42 = false;
+  bool avx2 = false;
+  bool avx512 = false;
+};
+
+X86Features QueryX86Features() {
+  X86Features features;
+  int regs[4] = {0, 0, 0, 0};
+
+  __cpuid(regs, 1);
+  features.sse42 = (regs[2] & (1 << 20)) != 0;
+  const bool osxsave = (regs[2] & (1 << 27)) != 0;
+  if (!osxsave) {
+    return features;
+  }
+
+  const std::uint64_t xcr0 = _xgetbv(0);
+  const bool ymm_enabled = (xcr0 & 0x6) == 0x6;
+  const bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+
+  __cpuidex(regs, 7, 0);
+  features.avx2 = ymm_enabled && (regs[1] & (1 << 5)) != 0;
+  // AVX-512 kernels need both the foundation (bit 16) and byte/word (bit 30) subsets
+  features.avx512 = zmm_enabled && (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 30)) != 0;
+  return features;
+}
+#endif
+
+}  // anonymous namespace
+
+bool IsSimdLevelSupported(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return true;
+#if defined(ARBORIS_ARCH_X86_64) && (defined(__GNUC__) || defined(__clang__))
+    case SimdLevel::kSse42:
+      return __builtin_cpu_supports("sse4.2");
+    case SimdLevel::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi");
+    case SimdLevel::kAvx512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#elif defined(ARBORIS_ARCH_X86_64) && defined(_MSC_VER)
+    case SimdLevel::kSse42:
+      return QueryX86Features().sse42;
+    case SimdLevel::kAvx2:
+      return QueryX86Features().avx2;
+    case SimdLevel::kAvx512:
+      return QueryX86Features().avx512;
+#elif defined(ARBORIS_ARCH_ARM64)
+    case SimdLevel::kNeon:
+      return true;  // Advanced SIMD is mandatory on AArch64
+#endif
+    default:
+      return false;
+  }
+}
+
+SimdLevel DetectSimdLevel() {
+  for (SimdLevel level : {SimdLevel::kAvx512, SimdLevel::kAvx2, SimdLevel::kSse42, SimdLevel::kNeon}) {
+    if (IsSimdLevelSupported(level)) {
+      return level;
+    }
+  }
+  return SimdLevel::kScalar;
+}
+
+}  // namespace arboris
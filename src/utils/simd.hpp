@@ -0,0 +1,51 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#ifndef SRC_UTILS_SIMD_HPP_
+#define SRC_UTILS_SIMD_HPP_
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ARBORIS_ARCH_X86_64 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ARBORIS_ARCH_ARM64 1
+#endif
+
+// Enables an instruction set for a single function so that vector kernels can live next to
+// portable code without compiling whole translation units with -m flags.
+#if defined(__GNUC__) || defined(__clang__)
+#define ARBORIS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ARBORIS_TARGET(isa)
+#endif
+
+namespace arboris {
+
+enum class SimdLevel : std::uint8_t {
+  kScalar,
+  kSse42,
+  kAvx2,
+  kAvx512,
+  kNeon,
+};
+
+/**
+ * @brief Detect the widest instruction set supported by both the running CPU and this build
+ * @return Best available SimdLevel, kScalar when no vector kernels can be used
+ */
+SimdLevel DetectSimdLevel();
+
+/**
+ * @brief Check whether kernels for a given level can run on this CPU
+ * @param level Instruction set to check
+ * @return true if the level is compiled in and supported at runtime
+ */
+bool IsSimdLevelSupported(SimdLevel level);
+
+}  // namespace arboris
+
+#endif  // SRC_UTILS_SIMD_HPP_
@@ -7,14 +7,24 @@
 #ifndef SRC_UTILS_STRING_POOL_HPP_
 #define SRC_UTILS_STRING_POOL_HPP_
 
-#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#include "utils/arena.hpp"
 
 namespace arboris {
 
+// Append-only character storage in stable blocks: views returned by Append() stay valid until Reset() or the
+// destruction of the pool, however much is appended later.
+// Consecutive appends are contiguous while they fit in the current block. The first block holds size bytes,
+// so a document's text copied into a pool sized to the document forms one range, and tag text ranges taken
+// with GetCursor() stay valid. Later blocks hold block_size bytes or the appended string, whichever is larger.
 class StringPool {
  public:
-  explicit StringPool(std::size_t size) {
-    pool_.reserve(size);
+  explicit StringPool(std::size_t size, std::size_t block_size = Arena::kDefaultBlockSize, bool huge_pages = false)
+      : arena_(block_size, huge_pages) {
+    arena_.Reserve(std::max<std::size_t>(size, 1));
   }
   StringPool(const StringPool&) = delete;
   StringPool& operator=(const StringPool&) = delete;
@@ -22,18 +32,42 @@ class StringPool {
   StringPool& operator=(StringPool&&) = delete;
   ~StringPool() = default;
 
+  // Where the next Append() starts if it fits in the current block
   [[nodiscard]] const char* GetCursor() const {
-    return pool_.data() + pool_.size();
+    return static_cast<const char*>(arena_.cursor());
   }
 
   [[nodiscard]] std::string_view Append(std::string_view str) {
-    const std::size_t current_size = pool_.size();
-    pool_ += str;
-    return {pool_.data() + current_size, str.size()};
+    if (str.empty()) {
+      return {GetCursor(), 0};
+    }
+    char* data = static_cast<char*>(arena_.Allocate(str.size(), 1));
+    std::copy(str.begin(), str.end(), data);
+    return {data, str.size()};
+  }
+
+  // Release every string in O(1), keeping the blocks for reuse
+  void Reset() noexcept {
+    arena_.Reset();
+  }
+
+  // Make the next size bytes of appends contiguous, e.g. after Reset() to copy in the text of another document
+  void Reserve(std::size_t size) {
+    arena_.Reserve(std::max<std::size_t>(size, 1));
+  }
+
+  // Bytes appended since construction or the last Reset()
+  [[nodiscard]] std::size_t bytes_used() const noexcept {
+    return arena_.bytes_used();
+  }
+
+  // Bytes held in blocks, used or not
+  [[nodiscard]] std::size_t bytes_reserved() const noexcept {
+    return arena_.bytes_reserved();
   }
 
  private:
-  std::string pool_;
+  Arena arena_;
 };
 
 }  // namespace arboris
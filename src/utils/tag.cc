@@ -4,132 +4,219 @@
  *   http://www.apache.org/licenses/LICENSE-2.0
  */
 
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
+#include "string/string.hpp"
 #include "utils/tag.hpp"
 
 namespace arboris {
+namespace {
+
+struct TagEntry {
+  std::string_view name;
+  Tag tag;
+};
+
+constexpr TagEntry kTagEntries[] = {
+    {"a", Tag::kA},
+    {"abbr", Tag::kAbbr},
+    {"address", Tag::kAddress},
+    {"area", Tag::kArea},
+    {"article", Tag::kArticle},
+    {"aside", Tag::kAside},
+    {"audio", Tag::kAudio},
+    {"b", Tag::kB},
+    {"base", Tag::kBase},
+    {"bdi", Tag::kBdi},
+    {"bdo", Tag::kBdo},
+    {"blockquote", Tag::kBlockquote},
+    {"body", Tag::kBody},
+    {"br", Tag::kBr},
+    {"button", Tag::kButton},
+    {"canvas", Tag::kCanvas},
+    {"caption", Tag::kCaption},
+    {"cite", Tag::kCite},
+    {"code", Tag::kCode},
+    {"col", Tag::kCol},
+    {"colgroup", Tag::kColgroup},
+    {"data", Tag::kData},
+    {"datalist", Tag::kDatalist},
+    {"dd", Tag::kDd},
+    {"del", Tag::kDel},
+    {"details", Tag::kDetails},
+    {"dfn", Tag::kDfn},
+    {"dialog", Tag::kDialog},
+    {"div", Tag::kDiv},
+    {"dl", Tag::kDl},
+    {"dt", Tag::kDt},
+    {"em", Tag::kEm},
+    {"embed", Tag::kEmbed},
+    {"fieldset", Tag::kFieldset},
+    {"figcaption", Tag::kFigcaption},
+    {"figure", Tag::kFigure},
+    {"footer", Tag::kFooter},
+    {"form", Tag::kForm},
+    {"h1", Tag::kH1},
+    {"h2", Tag::kH2},
+    {"h3", Tag::kH3},
+    {"h4", Tag::kH4},
+    {"h5", Tag::kH5},
+    {"h6", Tag::kH6},
+    {"head", Tag::kHead},
+    {"header", Tag::kHeader},
+    {"hgroup", Tag::kHgroup},
+    {"hr", Tag::kHr},
+    {"html", Tag::kHtml},
+    {"i", Tag::kI},
+    {"iframe", Tag::kIframe},
+    {"img", Tag::kImg},
+    {"input", Tag::kInput},
+    {"ins", Tag::kIns},
+    {"kbd", Tag::kKbd},
+    {"label", Tag::kLabel},
+    {"legend", Tag::kLegend},
+    {"li", Tag::kLi},
+    {"link", Tag::kLink},
+    {"main", Tag::kMain},
+    {"map", Tag::kMap},
+    {"mark", Tag::kMark},
+    {"menu", Tag::kMenu},
+    {"meta", Tag::kMeta},
+    {"meter", Tag::kMeter},
+    {"nav", Tag::kNav},
+    {"noscript", Tag::kNoscript},
+    {"object", Tag::kObject},
+    {"ol", Tag::kOl},
+    {"optgroup", Tag::kOptgroup},
+    {"option", Tag::kOption},
+    {"output", Tag::kOutput},
+    {"p", Tag::kP},
+    {"picture", Tag::kPicture},
+    {"pre", Tag::kPre},
+    {"progress", Tag::kProgress},
+    {"q", Tag::kQ},
+    {"rp", Tag::kRp},
+    {"rt", Tag::kRt},
+    {"ruby", Tag::kRuby},
+    {"s", Tag::kS},
+    {"samp", Tag::kSamp},
+    {"script", Tag::kScript},
+    {"search", Tag::kSearch},
+    {"section", Tag::kSection},
+    {"select", Tag::kSelect},
+    {"small", Tag::kSmall},
+    {"source", Tag::kSource},
+    {"span", Tag::kSpan},
+    {"strong", Tag::kStrong},
+    {"style", Tag::kStyle},
+    {"sub", Tag::kSub},
+    {"summary", Tag::kSummary},
+    {"sup", Tag::kSup},
+    {"table", Tag::kTable},
+    {"tbody", Tag::kTbody},
+    {"td", Tag::kTd},
+    {"template", Tag::kTemplate},
+    {"textarea", Tag::kTextarea},
+    {"tfoot", Tag::kTfoot},
+    {"th", Tag::kTh},
+    {"thead", Tag::kThead},
+    {"time", Tag::kTime},
+    {"title", Tag::kTitle},
+    {"tr", Tag::kTr},
+    {"track", Tag::kTrack},
+    {"u", Tag::kU},
+    {"ul", Tag::kUl},
+    {"var", Tag::kVar},
+    {"video", Tag::kVideo},
+    {"wbr", Tag::kWbr},
+};
+
+constexpr std::size_t kMaxTagNameLength = 10;  // "blockquote", "figcaption"
+constexpr std::uint32_t kTableBits = 10;
+constexpr std::size_t kTableSize = std::size_t{1} << kTableBits;
+
+// Lookup key: length, first two and last byte. Setting bit 0x20 folds ASCII letters to lowercase and leaves digits
+// unchanged; other bytes may collide, which the final name comparison rejects.
+constexpr std::uint32_t TagKey(std::string_view name) {
+  const auto fold = [](char c) { return static_cast<std::uint32_t>(static_cast<std::uint8_t>(c) | 0x20U); };
+  const std::uint32_t second = name.length() > 1 ? fold(name[1]) : 0;
+  return (static_cast<std::uint32_t>(name.length()) << 24) | (fold(name[0]) << 16) | (second << 8) |
+         fold(name.back());
+}
+
+constexpr std::uint32_t TagSlot(std::uint32_t key, std::uint32_t seed) {
+  return (key * seed) >> (32 - kTableBits);
+}
+
+constexpr bool IsPerfectSeed(std::uint32_t seed) {
+  std::array<bool, kTableSize> used{};
+  for (const auto& entry : kTagEntries) {
+    const std::uint32_t slot = TagSlot(TagKey(entry.name), seed);
+    if (used[slot]) {
+      return false;
+    }
+    used[slot] = true;
+  }
+  return true;
+}
+
+// Search odd multipliers until every tag lands in its own slot. Runs once, at compile time.
+constexpr std::uint32_t FindPerfectSeed() {
+  std::uint32_t seed = 0x9E3779B1U;
+  for (int attempt = 0; attempt < 100000; ++attempt) {
+    if (IsPerfectSeed(seed)) {
+      return seed;
+    }
+    seed = seed * 1664525U + 1013904223U;
+    seed |= 1U;
+  }
+  return 0;
+}
+
+constexpr std::uint32_t kPerfectSeed = FindPerfectSeed();
+static_assert(kPerfectSeed != 0, "no collision-free seed for the tag table; raise kTableBits");
+
+constexpr std::array<Tag, kTableSize> BuildSlotTable() {
+  std::array<Tag, kTableSize> table{};
+  for (const auto& entry : kTagEntries) {
+    table[TagSlot(TagKey(entry.name), kPerfectSeed)] = entry.tag;
+  }
+  return table;
+}
+
+constexpr std::array<std::string_view, kTagCount> BuildNameTable() {
+  std::array<std::string_view, kTagCount> names{};
+  for (const auto& entry : kTagEntries) {
+    names[static_cast<std::size_t>(entry.tag)] = entry.name;
+  }
+  return names;
+}
+
+constexpr std::array<Tag, kTableSize> kSlotTable = BuildSlotTable();
+constexpr std::array<std::string_view, kTagCount> kNameTable = BuildNameTable();
+
+static_assert(std::size(kTagEntries) == kTagCount - 1, "every Tag except kUnknown needs a name");
+
+}  // anonymous namespace
 
 Tag FromString(std::string_view tag_name) {
-  static const std::unordered_map<std::string_view, Tag> kTagMap = {
-      {"a", Tag::kA},
-      {"abbr", Tag::kAbbr},
-      {"address", Tag::kAddress},
-      {"area", Tag::kArea},
-      {"article", Tag::kArticle},
-      {"aside", Tag::kAside},
-      {"audio", Tag::kAudio},
-      {"b", Tag::kB},
-      {"base", Tag::kBase},
-      {"bdi", Tag::kBdi},
-      {"bdo", Tag::kBdo},
-      {"blockquote", Tag::kBlockquote},
-      {"body", Tag::kBody},
-      {"br", Tag::kBr},
-      {"button", Tag::kButton},
-      {"canvas", Tag::kCanvas},
-      {"caption", Tag::kCaption},
-      {"cite", Tag::kCite},
-      {"code", Tag::kCode},
-      {"col", Tag::kCol},
-      {"colgroup", Tag::kColgroup},
-      {"data", Tag::kData},
-      {"datalist", Tag::kDatalist},
-      {"dd", Tag::kDd},
-      {"del", Tag::kDel},
-      {"details", Tag::kDetails},
-      {"dfn", Tag::kDfn},
-      {"dialog", Tag::kDialog},
-      {"div", Tag::kDiv},
-      {"dl", Tag::kDl},
-      {"dt", Tag::kDt},
-      {"em", Tag::kEm},
-      {"embed", Tag::kEmbed},
-      {"fieldset", Tag::kFieldset},
-      {"figcaption", Tag::kFigcaption},
-      {"figure", Tag::kFigure},
-      {"footer", Tag::kFooter},
-      {"form", Tag::kForm},
-      {"h1", Tag::kH1},
-      {"h2", Tag::kH2},
-      {"h3", Tag::kH3},
-      {"h4", Tag::kH4},
-      {"h5", Tag::kH5},
-      {"h6", Tag::kH6},
-      {"head", Tag::kHead},
-      {"header", Tag::kHeader},
-      {"hgroup", Tag::kHgroup},
-      {"hr", Tag::kHr},
-      {"html", Tag::kHtml},
-      {"i", Tag::kI},
-      {"iframe", Tag::kIframe},
-      {"img", Tag::kImg},
-      {"input", Tag::kInput},
-      {"ins", Tag::kIns},
-      {"kbd", Tag::kKbd},
-      {"label", Tag::kLabel},
-      {"legend", Tag::kLegend},
-      {"li", Tag::kLi},
-      {"link", Tag::kLink},
-      {"main", Tag::kMain},
-      {"map", Tag::kMap},
-      {"mark", Tag::kMark},
-      {"menu", Tag::kMenu},
-      {"meta", Tag::kMeta},
-      {"meter", Tag::kMeter},
-      {"nav", Tag::kNav},
-      {"noscript", Tag::kNoscript},
-      {"object", Tag::kObject},
-      {"ol", Tag::kOl},
-      {"optgroup", Tag::kOptgroup},
-      {"option", Tag::kOption},
-      {"output", Tag::kOutput},
-      {"p", Tag::kP},
-      {"picture", Tag::kPicture},
-      {"pre", Tag::kPre},
-      {"progress", Tag::kProgress},
-      {"q", Tag::kQ},
-      {"rp", Tag::kRp},
-      {"rt", Tag::kRt},
-      {"ruby", Tag::kRuby},
-      {"s", Tag::kS},
-      {"samp", Tag::kSamp},
-      {"script", Tag::kScript},
-      {"search", Tag::kSearch},
-      {"section", Tag::kSection},
-      {"select", Tag::kSelect},
-      {"small", Tag::kSmall},
-      {"source", Tag::kSource},
-      {"span", Tag::kSpan},
-      {"strong", Tag::kStrong},
-      {"style", Tag::kStyle},
-      {"sub", Tag::kSub},
-      {"summary", Tag::kSummary},
-      {"sup", Tag::kSup},
-      {"table", Tag::kTable},
-      {"tbody", Tag::kTbody},
-      {"td", Tag::kTd},
-      {"template", Tag::kTemplate},
-      {"textarea", Tag::kTextarea},
-      {"tfoot", Tag::kTfoot},
-      {"th", Tag::kTh},
-      {"thead", Tag::kThead},
-      {"time", Tag::kTime},
-      {"title", Tag::kTitle},
-      {"tr", Tag::kTr},
-      {"track", Tag::kTrack},
-      {"u", Tag::kU},
-      {"ul", Tag::kUl},
-      {"var", Tag::kVar},
-      {"video", Tag::kVideo},
-      {"wbr", Tag::kWbr},
-  };
-
-  auto it = kTagMap.find(tag_name);
-  if (it == kTagMap.end()) {
+  if (tag_name.empty() || tag_name.length() > kMaxTagNameLength) {
     return Tag::kUnknown;
   }
-  return it->second;
+
+  const Tag candidate = kSlotTable[TagSlot(TagKey(tag_name), kPerfectSeed)];
+  if (candidate == Tag::kUnknown || !EqualsIgnoreAsciiCase(kNameTable[static_cast<std::size_t>(candidate)], tag_name)) {
+    return Tag::kUnknown;
+  }
+  return candidate;
+}
+
+std::string_view ToString(Tag tag) {
+  const auto index = static_cast<std::size_t>(tag);
+  return index < kTagCount ? kNameTable[index] : std::string_view{};
 }
 
 bool IsVoidTag(Tag tag) {
@@ -153,4 +240,59 @@ bool IsVoidTag(Tag tag) {
   }
 }
 
+bool IsBlockTag(Tag tag) {
+  switch (tag) {
+    case Tag::kAddress:
+    case Tag::kArticle:
+    case Tag::kAside:
+    case Tag::kBlockquote:
+    case Tag::kBody:
+    case Tag::kBr:
+    case Tag::kCaption:
+    case Tag::kDd:
+    case Tag::kDetails:
+    case Tag::kDialog:
+    case Tag::kDiv:
+    case Tag::kDl:
+    case Tag::kDt:
+    case Tag::kFieldset:
+    case Tag::kFigcaption:
+    case Tag::kFigure:
+    case Tag::kFooter:
+    case Tag::kForm:
+    case Tag::kH1:
+    case Tag::kH2:
+    case Tag::kH3:
+    case Tag::kH4:
+    case Tag::kH5:
+    case Tag::kH6:
+    case Tag::kHeader:
+    case Tag::kHgroup:
+    case Tag::kHr:
+    case Tag::kLegend:
+    case Tag::kLi:
+    case Tag::kMain:
+    case Tag::kMenu:
+    case Tag::kNav:
+    case Tag::kOl:
+    case Tag::kP:
+    case Tag::kPre:
+    case Tag::kSearch:
+    case Tag::kSection:
+    case Tag::kSummary:
+    case Tag::kTable:
+    case Tag::kTbody:
+    case Tag::kTd:
+    case Tag::kTfoot:
+    case Tag::kTh:
+    case Tag::kThead:
+    case Tag::kTitle:
+    case Tag::kTr:
+    case Tag::kUl:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace arboris
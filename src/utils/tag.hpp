@@ -7,6 +7,8 @@
 #ifndef SRC_UTILS_TAG_HPP_
 #define SRC_UTILS_TAG_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace arboris {
@@ -126,10 +128,27 @@ enum class Tag : std::uint8_t {
   kWbr,
 };
 
+inline constexpr std::size_t kTagCount = static_cast<std::size_t>(Tag::kWbr) + 1;
+
+/**
+ * @brief Look up a tag by name, ignoring ASCII case
+ * @param tag_name Tag name as written in the document (e.g. "div", "DIV", "Meta")
+ * @return Matching tag, or Tag::kUnknown
+ */
 Tag FromString(std::string_view tag_name);
 
+/**
+ * @brief Get the lowercase name of a tag
+ * @param tag Tag to name
+ * @return Tag name, or an empty view for Tag::kUnknown
+ */
+std::string_view ToString(Tag tag);
+
 bool IsVoidTag(Tag tag);
 
+// Tags that break the flow of text when rendered, like p, div, br and li, as opposed to inline tags like a or span
+bool IsBlockTag(Tag tag);
+
 }  // namespace arboris
 
 #endif  // SRC_UTILS_TAG_HPP_
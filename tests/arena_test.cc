@@ -0,0 +1,95 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "utils/arena.hpp"
+
+namespace arboris {
+namespace {
+
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+}  // anonymous namespace
+
+TEST(ArenaTest, AllocationsAreAligned) {
+  Arena arena(256);
+  for (std::size_t alignment : {1, 2, 8, 16, 64}) {
+    ASSERT_TRUE(arena.Allocate(1, 1) != nullptr);
+    const auto address = reinterpret_cast<std::uintptr_t>(arena.Allocate(3, alignment));
+    EXPECT_EQ(address % alignment, 0) << "alignment " << alignment;
+  }
+}
+
+TEST(ArenaTest, NewConstructsObjects) {
+  Arena arena;
+  Point* first = arena.New<Point>(1, 2);
+  Point* second = arena.New<Point>(3, 4);
+
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first->x, 1);
+  EXPECT_EQ(first->y, 2);
+  EXPECT_EQ(second->x, 3);
+  EXPECT_EQ(second->y, 4);
+  EXPECT_EQ(arena.bytes_used(), 2 * sizeof(Point));
+}
+
+TEST(ArenaTest, NewArrayCopiesItems) {
+  Arena arena;
+  const std::array<Point, 3> points{{{1, 2}, {3, 4}, {5, 6}}};
+  const std::span<Point> copy = arena.NewArray(std::span<const Point>(points));
+
+  ASSERT_EQ(copy.size(), 3);
+  EXPECT_NE(copy.data(), points.data());
+  EXPECT_EQ(copy[2].x, 5);
+  EXPECT_TRUE(arena.NewArray(std::span<const Point>()).empty());
+}
+
+TEST(ArenaTest, GrowsPastBlockSize) {
+  Arena arena(64);
+  void* small = arena.Allocate(48);
+  void* large = arena.Allocate(1000);
+
+  EXPECT_NE(small, large);
+  EXPECT_GE(arena.bytes_reserved(), 1064);
+  EXPECT_EQ(arena.bytes_used(), 1048);
+}
+
+TEST(ArenaTest, ReserveMakesRoomForContiguousBytes) {
+  Arena arena(64);
+  ASSERT_TRUE(arena.Allocate(60, 1) != nullptr);
+  arena.Reserve(100);
+
+  const auto* begin = static_cast<const std::byte*>(arena.cursor());
+  EXPECT_EQ(arena.Allocate(40, 1), begin);
+  EXPECT_EQ(arena.Allocate(60, 1), begin + 40);
+}
+
+TEST(ArenaTest, ResetReusesBlocks) {
+  Arena arena(128);
+  void* first = arena.Allocate(100);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(arena.Allocate(100) != nullptr);
+  }
+  const std::size_t reserved = arena.bytes_reserved();
+
+  arena.Reset();
+  EXPECT_EQ(arena.bytes_used(), 0);
+  EXPECT_EQ(arena.Allocate(100), first);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(arena.Allocate(100) != nullptr);
+  }
+  EXPECT_EQ(arena.bytes_reserved(), reserved);
+}
+
+}  // namespace arboris
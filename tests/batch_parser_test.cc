@@ -0,0 +1,142 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dom/batch_parser.hpp"
+#include "dom/dom_manager.hpp"
+
+namespace arboris {
+namespace {
+
+// Pages of very different sizes, some of them malformed
+std::vector<std::string> MakePages(int count) {
+  std::vector<std::string> pages;
+  for (int i = 0; i < count; ++i) {
+    std::string page = "<html><head><title>Page " + std::to_string(i) + "</title></head><body>";
+    for (int item = 0; item < (i * 7919) % 97; ++item) {
+      page += "<div class=item><p>Item " + std::to_string(item) + " <a href='/i/" + std::to_string(item) +
+              "'>more</a></p></div>";
+    }
+    page += i % 10 == 3 ? "<div></body></html>" : "</body></html>";
+    pages.push_back(std::move(page));
+  }
+  return pages;
+}
+
+// What a document looks like, to compare parses
+struct Summary {
+  bool valid = false;
+  std::size_t elements = 0;
+  std::size_t links = 0;
+  std::string title;
+  std::string text;
+
+  bool operator==(const Summary& other) const = default;
+};
+
+Summary Summarize(const DOMManager& document) {
+  Summary summary;
+  summary.valid = document.IsValid();
+  summary.elements = document.dom_indexer().elements().size();
+  summary.links = document.dom_indexer().FindByTag(Tag::kA).size();
+  if (const PostingList titles = document.dom_indexer().FindByTag(Tag::kTitle); !titles.empty()) {
+    summary.title = titles.front()->text_content();
+  }
+  document.ExtractText(*document.root(), {}, &summary.text);
+  return summary;
+}
+
+}  // anonymous namespace
+
+TEST(BatchParserTest, MatchesParsingEachDocumentAlone) {
+  const std::vector<std::string> pages = MakePages(200);
+  const std::vector<std::string_view> documents(pages.begin(), pages.end());
+  std::vector<Summary> expected;
+  for (std::string_view page : documents) {
+    expected.push_back(Summarize(DOMManager(page)));
+  }
+  EXPECT_FALSE(expected[3].valid);
+  EXPECT_TRUE(expected[4].valid);
+
+  for (const std::size_t threads : {1, 3, 8}) {
+    const std::vector<Summary> summaries = ParseBatch(
+        documents, {.threads = threads}, [](std::size_t, const DOMManager& document) { return Summarize(document); });
+    EXPECT_EQ(summaries, expected) << threads << " threads";
+  }
+}
+
+TEST(BatchParserTest, ReportsStrayCloseTagsAsInvalid) {
+  const std::vector<std::string_view> documents = {"</p>", "<p>ok</p>", "text</b>", "<div></div></div>", "<i>ok</i>"};
+  const auto valid = ParseBatch(documents, {.threads = 2}, [](std::size_t, const DOMManager& document) {
+    return static_cast<char>(document.IsValid());
+  });
+  EXPECT_EQ(valid, (std::vector<char>{0, 1, 0, 0, 1}));
+}
+
+TEST(BatchParserTest, AppliesDocumentOptions) {
+  const std::vector<std::string> pages = MakePages(20);
+  const std::vector<std::string_view> documents(pages.begin(), pages.end());
+  const BatchParseOptions options = {.document = {.build_flat_document = true, .zero_copy_text = true}, .threads = 2};
+  const auto sizes = ParseBatch(documents, options, [&](std::size_t index, const DOMManager& document) {
+    // Zero-copy text nodes point into the document itself
+    const TagNode* title = document.dom_indexer().FindByTag(Tag::kTitle).front();
+    EXPECT_EQ(title->text_content().data(), documents[index].data() + documents[index].find("Page"));
+    return document.flat_document()->size();
+  });
+  for (std::size_t i = 0; i < documents.size(); ++i) {
+    EXPECT_EQ(sizes[i], DOMManager(documents[i], options.document).flat_document()->size()) << i;
+  }
+}
+
+TEST(BatchParserTest, CallsBackOncePerDocumentFromTheWorkers) {
+  const std::vector<std::string> pages = MakePages(64);
+  const std::vector<std::string_view> documents(pages.begin(), pages.end());
+  std::vector<std::atomic<int>> calls(documents.size());
+  std::atomic<int> total = 0;
+  ParseBatch(documents, {.threads = 4}, [&](std::size_t index, const DOMManager& document) {
+    EXPECT_EQ(document.dom_indexer().FindByTag(Tag::kTitle).front()->text_content(),
+              "Page " + std::to_string(index));
+    ++calls[index];
+    ++total;
+  });
+  EXPECT_EQ(total, 64);
+  for (const std::atomic<int>& count : calls) {
+    EXPECT_EQ(count, 1);
+  }
+
+  // More threads than documents, and no documents at all
+  int single = 0;
+  ParseBatch(std::span(documents).first(1), {.threads = 16}, [&](std::size_t, const DOMManager&) { ++single; });
+  EXPECT_EQ(single, 1);
+  ParseBatch({}, {}, [](std::size_t, const DOMManager&) { ADD_FAILURE(); });
+}
+
+TEST(BatchParserTest, RethrowsTheFirstExceptionOfACallback) {
+  const std::vector<std::string> pages = MakePages(64);
+  const std::vector<std::string_view> documents(pages.begin(), pages.end());
+  for (const std::size_t threads : {1, 4}) {
+    std::atomic<int> calls = 0;
+    EXPECT_THROW(ParseBatch(documents, {.threads = threads},
+                            [&](std::size_t, const DOMManager&) {
+                              if (++calls == 1) {
+                                throw std::runtime_error("extraction failed");
+                              }
+                            }),
+                 std::runtime_error)
+        << threads << " threads";
+    EXPECT_LT(calls, 64) << threads << " threads";
+  }
+}
+
+}  // namespace arboris
@@ -0,0 +1,145 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/dom_manager.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<div id=main class='card wide'>"
+    "<p class=card>one</p><span class='wide  card card'>two</span><p class=note id=main>three</p>"
+    "</div><p class='Card'>four</p>";
+
+std::vector<std::string_view> Texts(const std::vector<TagNode*>& nodes) {
+  std::vector<std::string_view> texts;
+  for (const TagNode* node : nodes) {
+    texts.push_back(node->text_content());
+  }
+  return texts;
+}
+
+std::vector<TagNode*> ToVector(PostingList list) {
+  return {list.begin(), list.end()};
+}
+
+}  // anonymous namespace
+
+TEST(DOMIndexerTest, FindByTag) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Texts(ToVector(manager.dom_indexer().FindByTag(Tag::kP))),
+            (std::vector<std::string_view>{"one", "three", "four"}));
+  EXPECT_TRUE(manager.dom_indexer().FindByTag(Tag::kTable).empty());
+}
+
+TEST(DOMIndexerTest, FindById) {
+  DOMManager manager(kDocument);
+  const TagNode* main = manager.dom_indexer().FindById("main");
+  ASSERT_NE(main, nullptr);
+  // The first element with a duplicated id wins
+  EXPECT_EQ(main->tag(), Tag::kDiv);
+  EXPECT_EQ(manager.dom_indexer().FindById("missing"), nullptr);
+  EXPECT_EQ(manager.dom_indexer().FindById(""), nullptr);
+}
+
+TEST(DOMIndexerTest, FindAllById) {
+  DOMManager manager(kDocument);
+  const PostingList mains = manager.dom_indexer().FindAllById("main");
+  ASSERT_EQ(mains.size(), 2);
+  EXPECT_EQ(mains[0]->tag(), Tag::kDiv);
+  EXPECT_EQ(mains[1]->text_content(), "three");
+  EXPECT_TRUE(manager.dom_indexer().FindAllById("missing").empty());
+}
+
+TEST(DOMIndexerTest, Elements) {
+  DOMManager manager(kDocument);
+  const PostingList elements = manager.dom_indexer().elements();
+  ASSERT_EQ(elements.size(), 5);
+  EXPECT_EQ(elements[0]->tag(), Tag::kDiv);
+  EXPECT_EQ(elements[4]->text_content(), "four");
+}
+
+TEST(DOMIndexerTest, FindByClass) {
+  DOMManager manager(kDocument);
+  const PostingList cards = manager.dom_indexer().FindByClass("card");
+
+  // In document order, each element once, case-sensitive
+  ASSERT_EQ(cards.size(), 3);
+  EXPECT_EQ(cards[0]->tag(), Tag::kDiv);
+  EXPECT_EQ(cards[1]->text_content(), "one");
+  EXPECT_EQ(cards[2]->text_content(), "two");
+  EXPECT_EQ(manager.dom_indexer().FindByClass("Card").size(), 1);
+  EXPECT_TRUE(manager.dom_indexer().FindByClass("missing").empty());
+}
+
+TEST(DOMIndexerTest, FindByTagAndClass) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Texts(manager.dom_indexer().FindByTagAndClass(Tag::kP, "card")), (std::vector<std::string_view>{"one"}));
+  EXPECT_EQ(Texts(manager.dom_indexer().FindByTagAndClass(Tag::kSpan, "wide")), (std::vector<std::string_view>{"two"}));
+  EXPECT_TRUE(manager.dom_indexer().FindByTagAndClass(Tag::kSpan, "note").empty());
+}
+
+TEST(DOMIndexerTest, AttributeIndexes) {
+  DOMManager manager(
+      "<meta property='og:title' content=t><meta property='OG:Type' content=a><meta property=og>"
+      "<a HREF=/x>x</a><a>none</a><link rel=canonical href=/c><link rel=Canonical>",
+      {.dom_indexer = {.attributes = {"href"}, .attribute_values = {"property", "REL"}}});
+  const DOMIndexer& indexer = manager.dom_indexer();
+  EXPECT_EQ(indexer.FindAttributeIndex("src"), nullptr);
+
+  const AttributeIndex* href = indexer.FindAttributeIndex("Href");
+  ASSERT_NE(href, nullptr);
+  EXPECT_FALSE(href->values_indexed());
+  ASSERT_EQ(href->nodes().size(), 2);
+  EXPECT_EQ(href->nodes()[0]->tag(), Tag::kA);
+  EXPECT_EQ(href->nodes()[1]->tag(), Tag::kLink);
+
+  const AttributeIndex* property = indexer.FindAttributeIndex("property");
+  ASSERT_NE(property, nullptr);
+  EXPECT_TRUE(property->values_indexed());
+  EXPECT_EQ(property->nodes().size(), 3);
+  EXPECT_EQ(property->FindPrefix("og:", false).size(), 1);
+  EXPECT_EQ(property->FindPrefix("og:", true).size(), 2);
+  EXPECT_EQ(property->FindPrefix("og", false).size(), 2);
+  EXPECT_EQ(property->FindValue("og", false).size(), 1);
+  EXPECT_TRUE(property->FindValue("og:type", false).empty());
+  EXPECT_EQ(property->FindValue("og:type", true).size(), 1);
+
+  const AttributeIndex* rel = indexer.FindAttributeIndex("rel");
+  ASSERT_NE(rel, nullptr);
+  const std::vector<TagNode*> canonical = rel->FindValue("canonical", true);
+  ASSERT_EQ(canonical.size(), 2);
+  EXPECT_LT(canonical[0]->in(), canonical[1]->in());
+  EXPECT_EQ(rel->FindValue("canonical", false).size(), 1);
+}
+
+TEST(DOMIndexerTest, IntersectShortAndLongLists) {
+  // One marked <li> among many: the short list is searched in the long one
+  std::string document = "<ul>";
+  for (int i = 0; i < 500; ++i) {
+    document += i % 100 == 7 ? "<li class=x>" + std::to_string(i) + "</li>" : "<li>" + std::to_string(i) + "</li>";
+  }
+  document += "</ul><p class=x>p</p>";
+  DOMManager manager(document);
+
+  const PostingList items = manager.dom_indexer().FindByTag(Tag::kLi);
+  const PostingList marked = manager.dom_indexer().FindByClass("x");
+  ASSERT_EQ(items.size(), 500);
+  ASSERT_EQ(marked.size(), 6);
+
+  const std::vector<TagNode*> both = IntersectPostingLists(items, marked);
+  EXPECT_EQ(Texts(both), (std::vector<std::string_view>{"7", "107", "207", "307", "407"}));
+  EXPECT_EQ(IntersectPostingLists(marked, items), both);
+  EXPECT_TRUE(IntersectPostingLists(items, {}).empty());
+}
+
+}  // namespace arboris
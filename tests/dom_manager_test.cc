@@ -0,0 +1,289 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "dom/text_node.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kSimpleDocument = "<html><head><title>Test</title></head><body><p>Hello</p></body></html>";
+constexpr std::string_view kVoidTags = "<div><br><img><p>text</p></div>";
+constexpr std::string_view kMismatchedClose = "<div><p>text</div>";
+constexpr std::string_view kUnclosed = "<div><p>text</p>";
+constexpr std::string_view kStreamDocument =
+    "<!DOCTYPE html><html><head><title>a < b</title><style>p > b {}</style></head>"
+    "<body class=\"x y\"><p id=first>Hello<br/>World</p><!-- </p> --></body></html>";
+
+}  // anonymous namespace
+
+TEST(DOMManagerTest, ParsesBalancedDocument) {
+  DOMManager manager(kSimpleDocument);
+  EXPECT_TRUE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, VoidTagsDoNotNeedCloseTags) {
+  DOMManager manager(kVoidTags);
+  EXPECT_TRUE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, MismatchedCloseTagIsInvalid) {
+  DOMManager manager(kMismatchedClose);
+  EXPECT_FALSE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, StrayCloseTagIsInvalid) {
+  for (std::string_view document : {"</p>", "text</b>", "<div></div></div>"}) {
+    DOMManager manager(document);
+    EXPECT_FALSE(manager.IsValid()) << document;
+
+    DOMManager streamed;
+    EXPECT_FALSE(streamed.Feed(document) && streamed.Finish()) << document;
+    EXPECT_FALSE(streamed.IsValid()) << document;
+  }
+}
+
+TEST(DOMManagerTest, UnclosedTagIsInvalid) {
+  DOMManager manager(kUnclosed);
+  EXPECT_FALSE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, BuildsLinkedTree) {
+  constexpr std::string_view kDocument = "<div id=main class='a b'>one<br>two<p>three</p></div><span></span>";
+  DOMManager manager(kDocument);
+  ASSERT_TRUE(manager.IsValid());
+
+  const TagNode* root = manager.root();
+  EXPECT_EQ(root->node_id(), 0);
+  EXPECT_EQ(root->parent(), nullptr);
+
+  const TagNode* div = root->first_child()->As<TagNode>();
+  ASSERT_NE(div, nullptr);
+  EXPECT_EQ(div->tag(), Tag::kDiv);
+  EXPECT_EQ(div->parent(), root);
+  EXPECT_EQ(div->id(), "main");
+  EXPECT_TRUE(div->classes().Contains("b"));
+  ASSERT_NE(div->FindAttribute("ID"), nullptr);
+  EXPECT_EQ(div->attributes().size(), 2);
+
+  const TagNode* span = div->next_sibling()->As<TagNode>();
+  ASSERT_NE(span, nullptr);
+  EXPECT_EQ(span->tag(), Tag::kSpan);
+  EXPECT_EQ(span->next_sibling(), nullptr);
+  EXPECT_EQ(root->last_child(), span);
+
+  // one, <br>, two, <p>
+  std::vector<NodeType> types;
+  for (const BaseNode* child : div->children()) {
+    EXPECT_EQ(child->parent(), div);
+    types.push_back(child->node_type());
+  }
+  EXPECT_EQ(types, (std::vector<NodeType>{NodeType::kText, NodeType::kTag, NodeType::kText, NodeType::kTag}));
+  EXPECT_EQ(div->first_child()->As<TextNode>()->text_content(), "one");
+  EXPECT_TRUE(div->first_child()->next_sibling()->As<TagNode>()->children().empty());
+}
+
+TEST(DOMManagerTest, NodeIdsAreUnique) {
+  DOMManager manager(kStreamDocument);
+  ASSERT_TRUE(manager.IsValid());
+  EXPECT_GT(manager.arena().bytes_used(), 0);
+
+  std::set<std::uint32_t> ids{manager.root()->node_id()};
+  std::vector<const TagNode*> pending{manager.root()};
+  while (!pending.empty()) {
+    const TagNode* node = pending.back();
+    pending.pop_back();
+    for (const BaseNode* child : node->children()) {
+      EXPECT_TRUE(ids.insert(child->node_id()).second) << "duplicate id " << child->node_id();
+      if (const TagNode* tag_node = child->As<TagNode>()) {
+        pending.push_back(tag_node);
+      }
+    }
+  }
+  EXPECT_GT(ids.size(), 10);
+}
+
+TEST(DOMManagerTest, CopiesTextByDefault) {
+  const std::string document = "<p>one<b>two</b></p>";
+  DOMManager manager(document);
+  const TagNode* p = manager.root()->first_child()->As<TagNode>();
+  const std::string_view text = p->first_child()->text_content();
+
+  EXPECT_EQ(text, "one");
+  EXPECT_FALSE(text.data() >= document.data() && text.data() < document.data() + document.size());
+  EXPECT_EQ(p->text_content(), "onetwo");
+}
+
+TEST(DOMManagerTest, ZeroCopyTextPointsIntoContent) {
+  auto document = std::make_shared<std::string>("<p>one<b>two</b></p>");
+  const std::string_view content = *document;
+  DOMManager manager(document, content, {.zero_copy_text = true});
+  document.reset();  // The manager keeps the content alive
+
+  ASSERT_TRUE(manager.IsValid());
+  const TagNode* p = manager.root()->first_child()->As<TagNode>();
+  const std::string_view text = p->first_child()->text_content();
+  EXPECT_EQ(text, "one");
+  EXPECT_EQ(text.data(), content.data() + 3);
+
+  // Element text is the source between its tags
+  EXPECT_EQ(p->text_content(), "one<b>two</b>");
+  EXPECT_EQ(p->last_child()->As<TagNode>()->text_content(), "two");
+}
+
+TEST(DOMManagerTest, FeedAcceptsChunksSplitAnywhere) {
+  ASSERT_TRUE(DOMManager(kStreamDocument).IsValid());
+
+  for (std::size_t split = 0; split <= kStreamDocument.length(); ++split) {
+    DOMManager manager;
+    // Chunks are temporaries, so the DOM must not refer to them
+    EXPECT_TRUE(manager.Feed(std::string(kStreamDocument.substr(0, split)))) << "split at " << split;
+    EXPECT_TRUE(manager.Feed(std::string(kStreamDocument.substr(split)))) << "split at " << split;
+    EXPECT_TRUE(manager.Finish()) << "split at " << split;
+    EXPECT_TRUE(manager.IsValid()) << "split at " << split;
+  }
+}
+
+TEST(DOMManagerTest, FeedKeepsLargeTokensWhole) {
+  std::string script;
+  std::string text;
+  while (script.size() < 2 * 1024 * 1024) {
+    script += "if (a < b) { s = \"</p>\"; }\n";
+    text += "Some \"quoted\" text = 'more' text > less\n";
+  }
+  const std::string document = "<html><head><script>" + script + "</script></head><body><!--" + script +
+                               "--><p class=big>" + text + "</p></body></html>";
+
+  // 16 KB chunks, released after each call, so the script fills several blocks as it grows
+  DOMManager manager;
+  constexpr std::size_t kChunkSize = 16 * 1024;
+  for (std::size_t pos = 0; pos < document.size(); pos += kChunkSize) {
+    ASSERT_TRUE(manager.Feed(document.substr(pos, kChunkSize))) << pos;
+  }
+  ASSERT_TRUE(manager.Finish());
+  ASSERT_TRUE(manager.IsValid());
+
+  const TagNode* script_node = manager.dom_indexer().FindByTag(Tag::kScript).front();
+  EXPECT_EQ(script_node->first_child()->As<TextNode>()->text_content(), script);
+  const TagNode* paragraph = manager.dom_indexer().FindByClass("big").front();
+  EXPECT_EQ(paragraph->first_child()->As<TextNode>()->text_content(), text);
+}
+
+TEST(DOMManagerTest, FeedByteByByte) {
+  DOMManager manager;
+  for (const char c : kStreamDocument) {
+    ASSERT_TRUE(manager.Feed(std::string_view(&c, 1)));
+  }
+  EXPECT_TRUE(manager.Finish());
+  EXPECT_TRUE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, StreamedUnclosedTagIsInvalid) {
+  DOMManager manager;
+  EXPECT_TRUE(manager.Feed(kUnclosed.substr(0, 7)));
+  EXPECT_TRUE(manager.Feed(kUnclosed.substr(7)));
+  EXPECT_TRUE(manager.Finish());
+  EXPECT_FALSE(manager.IsValid());
+}
+
+TEST(DOMManagerTest, FeedRejectsMalformedInputAndFinishedDocuments) {
+  DOMManager malformed;
+  EXPECT_FALSE(malformed.Feed("<div><>"));
+  EXPECT_FALSE(malformed.Feed("</div>"));
+  EXPECT_FALSE(malformed.IsValid());
+
+  DOMManager finished;
+  EXPECT_TRUE(finished.Feed(kSimpleDocument));
+  EXPECT_TRUE(finished.Finish());
+  EXPECT_FALSE(finished.Feed("<p>"));
+  EXPECT_FALSE(finished.Finish());
+}
+
+TEST(DOMManagerTest, ResetParsesAnotherDocumentInPlace) {
+  constexpr std::string_view kSmall = "<p id=a>small</p>";
+  const std::string large = "<div class=big>" + std::string(100000, 'x') + "<b>bold</b></div><p id=b>end</p>";
+
+  for (const DOMManagerOptions& options :
+       {DOMManagerOptions{}, DOMManagerOptions{.build_flat_document = true}, DOMManagerOptions{.zero_copy_text = true},
+        DOMManagerOptions{.dom_indexer = {.attributes = {"class"}, .attribute_values = {"id"}}}}) {
+    DOMManager manager(kSmall, options);
+    for (std::string_view next : {std::string_view(large), kSimpleDocument, kMismatchedClose, kSmall}) {
+      const DOMManager fresh(next, options);
+      EXPECT_EQ(manager.Reset(next), fresh.IsValid());
+      EXPECT_EQ(manager.IsValid(), fresh.IsValid());
+
+      const PostingList elements = manager.dom_indexer().elements();
+      const PostingList fresh_elements = fresh.dom_indexer().elements();
+      ASSERT_EQ(elements.size(), fresh_elements.size());
+      for (std::size_t i = 0; i < elements.size(); ++i) {
+        EXPECT_EQ(elements[i]->node_id(), fresh_elements[i]->node_id());
+        EXPECT_EQ(elements[i]->tag(), fresh_elements[i]->tag());
+        EXPECT_EQ(elements[i]->in(), fresh_elements[i]->in());
+        EXPECT_EQ(elements[i]->out(), fresh_elements[i]->out());
+        // Text ranges of tags stay contiguous after growing into a larger document
+        EXPECT_EQ(elements[i]->text_content(), fresh_elements[i]->text_content());
+      }
+      EXPECT_EQ(manager.root()->first_child()->parent(), manager.root());
+      EXPECT_EQ(manager.dom_indexer().FindById("a") != nullptr, fresh.dom_indexer().FindById("a") != nullptr);
+      EXPECT_EQ(manager.dom_indexer().FindByClass("big").size(), fresh.dom_indexer().FindByClass("big").size());
+      if (const AttributeIndex* index = manager.dom_indexer().FindAttributeIndex("id")) {
+        const AttributeIndex* fresh_index = fresh.dom_indexer().FindAttributeIndex("id");
+        EXPECT_EQ(index->FindValue("b", false).size(), fresh_index->FindValue("b", false).size());
+      }
+      if (options.build_flat_document) {
+        const FlatDocument& flat = *manager.flat_document();
+        ASSERT_EQ(flat.size(), fresh.flat_document()->size());
+        for (std::uint32_t id = 0; id < flat.size(); ++id) {
+          EXPECT_EQ(flat.tag(id), fresh.flat_document()->tag(id));
+          EXPECT_EQ(flat.parent(id), fresh.flat_document()->parent(id));
+          EXPECT_EQ(flat.text(id), fresh.flat_document()->text(id));
+        }
+      }
+    }
+  }
+}
+
+TEST(DOMManagerTest, AttributesOutliveTheInputWithAStringPool) {
+  const DOMManagerOptions options = {.build_flat_document = true,
+                                     .dom_indexer = {.attributes = {"href"}, .attribute_values = {"data-kind"}}};
+  auto html = std::make_unique<std::string>(
+      "<div id=main class='card wide' data-kind=list><a href=\"/next\" hidden>next</a></div>");
+  const DOMManager manager(*html, options);
+  ASSERT_TRUE(manager.IsValid());
+
+  // Overwrite the input before releasing it, so stale views cannot match by chance
+  std::fill(html->begin(), html->end(), '#');
+  html.reset();
+
+  const TagNode* div = manager.dom_indexer().FindById("main");
+  ASSERT_NE(div, nullptr);
+  EXPECT_EQ(div->id(), "main");
+  EXPECT_EQ(std::vector<std::string_view>(div->classes().begin(), div->classes().end()),
+            (std::vector<std::string_view>{"card", "wide"}));
+  EXPECT_EQ(manager.dom_indexer().FindByClass("wide").size(), 1);
+  ASSERT_NE(div->FindAttribute("data-kind"), nullptr);
+  EXPECT_EQ(div->FindAttribute("data-kind")->value, "list");
+  EXPECT_EQ(manager.dom_indexer().FindAttributeIndex("data-kind")->FindValue("list", false).size(), 1);
+
+  const TagNode* link = manager.dom_indexer().FindByTag(Tag::kA).front();
+  ASSERT_EQ(link->attributes().size(), 2);
+  EXPECT_EQ(link->attributes()[0].name, "href");
+  EXPECT_EQ(link->attributes()[0].value, "/next");
+  EXPECT_EQ(link->attributes()[1].name, "hidden");
+  EXPECT_TRUE(link->attributes()[1].value.empty());
+  EXPECT_EQ(link->text_content(), "next");
+  EXPECT_EQ(manager.flat_document()->FindAttribute(link->node_id(), "href")->value, "/next");
+}
+
+}  // namespace arboris
@@ -0,0 +1,135 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "dom/flat_document.hpp"
+#include "dom/text_node.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>T</title></head><body class=main>"
+    "<div id=a><img src=1.png><p>one<img src=2.png alt=''>two</p></div>"
+    "<ul><li>x</li><li><img src=3.png></li></ul></body></html>";
+
+// Compare the flat columns of a node and its descendants with the linked tree
+void ExpectSameSubtree(const FlatDocument& document, const BaseNode* node) {
+  const std::uint32_t id = node->node_id();
+  ASSERT_LT(id, document.size());
+  EXPECT_EQ(document.node_type(id), node->node_type());
+  EXPECT_EQ(document.in(id), node->in());
+  EXPECT_EQ(document.out(id), node->out());
+  EXPECT_EQ(document.parent(id), node->parent() ? node->parent()->node_id() : FlatDocument::kNoNode);
+  EXPECT_EQ(document.next_sibling(id), node->next_sibling() ? node->next_sibling()->node_id() : FlatDocument::kNoNode);
+  EXPECT_EQ(document.text(id), node->text_content());
+
+  const TagNode* tag_node = node->As<TagNode>();
+  if (tag_node == nullptr) {
+    return;
+  }
+  EXPECT_EQ(document.tag(id), tag_node->tag());
+  EXPECT_EQ(document.first_child(id), tag_node->first_child() ? tag_node->first_child()->node_id()
+                                                              : FlatDocument::kNoNode);
+  ASSERT_EQ(document.attributes(id).size(), tag_node->attributes().size());
+  for (std::size_t i = 0; i < tag_node->attributes().size(); ++i) {
+    EXPECT_EQ(document.attributes(id)[i].name, tag_node->attributes()[i].name);
+    EXPECT_EQ(document.attributes(id)[i].value, tag_node->attributes()[i].value);
+  }
+  for (const BaseNode* child : tag_node->children()) {
+    ExpectSameSubtree(document, child);
+  }
+}
+
+}  // anonymous namespace
+
+TEST(FlatDocumentTest, MatchesLinkedTree) {
+  DOMManager manager(kDocument, {.build_flat_document = true});
+  ASSERT_TRUE(manager.IsValid());
+  ASSERT_NE(manager.flat_document(), nullptr);
+  ExpectSameSubtree(*manager.flat_document(), manager.root());
+}
+
+TEST(FlatDocumentTest, IdsArePreorder) {
+  DOMManager manager(kDocument, {.build_flat_document = true});
+  const FlatDocument& document = *manager.flat_document();
+
+  // Timestamps grow with the id, and every subtree is a contiguous id range
+  for (std::uint32_t id = 1; id < document.size(); ++id) {
+    EXPECT_LT(document.in(id - 1), document.in(id));
+    const std::uint32_t parent = document.parent(id);
+    EXPECT_LT(parent, id);
+    EXPECT_LE(document.subtree_end(id), document.subtree_end(parent));
+  }
+  EXPECT_EQ(document.subtree_end(0), document.size());
+}
+
+TEST(FlatDocumentTest, ColumnScans) {
+  DOMManager manager(kDocument, {.build_flat_document = true});
+  const FlatDocument& document = *manager.flat_document();
+
+  const auto tags = document.tags();
+  EXPECT_EQ(std::count(tags.begin(), tags.end(), Tag::kImg), 3);
+
+  // Images below the div, found by scanning its id range
+  const auto div = static_cast<std::uint32_t>(std::find(tags.begin(), tags.end(), Tag::kDiv) - tags.begin());
+  std::vector<std::string_view> sources;
+  for (std::uint32_t id = div; id < document.subtree_end(div); ++id) {
+    if (document.tag(id) == Tag::kImg) {
+      sources.push_back(document.FindAttribute(id, "src")->value);
+    }
+  }
+  EXPECT_EQ(sources, (std::vector<std::string_view>{"1.png", "2.png"}));
+}
+
+TEST(FlatDocumentTest, StreamedDocument) {
+  DOMManager manager({.build_flat_document = true});
+  for (const char c : kDocument) {
+    ASSERT_TRUE(manager.Feed(std::string_view(&c, 1)));
+  }
+  ASSERT_TRUE(manager.Finish());
+  ExpectSameSubtree(*manager.flat_document(), manager.root());
+}
+
+TEST(FlatDocumentTest, NotBuiltByDefault) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(manager.flat_document(), nullptr);
+}
+
+TEST(FlatDocumentTest, AppendAndClose) {
+  FlatDocument document;
+  HtmlToken token;
+  token.tag = Tag::kP;
+  token.attributes.push_back({"class", "x"});
+
+  constexpr std::string_view kSource = "<p>hi</p>";
+  const std::uint32_t p = document.AppendTag(0, token, 1, kSource.data() + 3);
+  const std::uint32_t text = document.AppendText(p, kSource.substr(3, 2), 2);
+
+  // Open tags extend to the end of the document
+  EXPECT_EQ(document.subtree_end(p), 3);
+  EXPECT_EQ(document.out(p), 0);
+
+  document.CloseTag(p, 3, kSource.data() + 5);
+  EXPECT_EQ(document.size(), 3);
+  EXPECT_EQ(document.first_child(0), p);
+  EXPECT_EQ(document.first_child(p), text);
+  EXPECT_EQ(document.parent(text), p);
+  EXPECT_EQ(document.node_type(text), NodeType::kText);
+  EXPECT_EQ(document.text(text), "hi");
+  EXPECT_EQ(document.text(p), "hi");
+  EXPECT_EQ(document.out(p), 3);
+  EXPECT_EQ(document.FindAttribute(p, "CLASS")->value, "x");
+  EXPECT_TRUE(document.attributes(text).empty());
+}
+
+}  // namespace arboris
@@ -0,0 +1,154 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "dom/frozen_document.hpp"
+#include "query/query.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><body><div id=main class=card><p class=lead>one</p><p>two <a href=/x>link</a></p></div>"
+    "<div class=card><span>three</span></div></body></html>";
+
+std::string Catalog(int products) {
+  std::string html = "<html><body><ul id=catalog>";
+  for (int i = 0; i < products; ++i) {
+    const std::string n = std::to_string(i);
+    html += "<li class='product" + std::string(i % 3 == 0 ? " sale" : "") + "' id=p" + n + "><h2>Product " + n +
+            "</h2><p>Description of product " + n + "</p><a href='/buy/" + n + "'>Buy</a></li>";
+  }
+  html += "</ul></body></html>";
+  return html;
+}
+
+// Node ids of the elements a query selects, and the text of the whole document
+struct Answers {
+  std::vector<std::vector<std::uint32_t>> selected;
+  std::string text;
+
+  bool operator==(const Answers& other) const = default;
+};
+
+Answers Answer(const FrozenDocument& document, const std::vector<Query>& queries) {
+  Answers answers;
+  for (const Query& query : queries) {
+    std::vector<std::uint32_t>& ids = answers.selected.emplace_back();
+    for (const TagNode* node : query.Select(document.dom_indexer())) {
+      ids.push_back(node->node_id());
+    }
+  }
+  document.ExtractText(*document.root(), {}, &answers.text);
+  return answers;
+}
+
+}  // anonymous namespace
+
+TEST(FrozenDocumentTest, ViewsTheSameNodes) {
+  DOMManager manager(kDocument, {.build_flat_document = true});
+  const FrozenDocument document = manager.Freeze();
+  EXPECT_TRUE(manager.frozen());
+  EXPECT_TRUE(manager.IsValid());
+
+  EXPECT_EQ(document.root(), manager.root());
+  EXPECT_EQ(&document.dom_indexer(), &manager.dom_indexer());
+  EXPECT_EQ(document.flat_document(), manager.flat_document());
+  EXPECT_EQ(document.FindById("main"), manager.dom_indexer().FindById("main"));
+
+  const ConstPostingList paragraphs = document.FindByTag(Tag::kP);
+  ASSERT_EQ(paragraphs.size(), 2);
+  EXPECT_EQ(paragraphs[0]->text_content(), "one");
+  EXPECT_EQ(document.FindByClass("card").size(), 2);
+  EXPECT_TRUE(document.FindByClass("missing").empty());
+
+  std::string text;
+  EXPECT_EQ(document.ExtractText(*document.root(), {}, &text), 16);
+  EXPECT_EQ(text, "onetwo linkthree");
+
+  // Freezing again gives the same view
+  EXPECT_EQ(manager.Freeze().root(), document.root());
+}
+
+TEST(FrozenDocumentTest, FinishesStreamedDocumentsAndRejectsMoreInput) {
+  DOMManager manager;
+  EXPECT_TRUE(manager.Feed(kDocument.substr(0, 40)));
+  EXPECT_TRUE(manager.Feed(std::string(kDocument.substr(40))));
+  const FrozenDocument document = manager.Freeze();
+  EXPECT_TRUE(manager.IsValid());
+  EXPECT_EQ(document.FindByTag(Tag::kLi).size(), 0);
+  EXPECT_EQ(document.FindByTag(Tag::kSpan).size(), 1);
+
+  EXPECT_FALSE(manager.Feed("<p>"));
+  EXPECT_FALSE(manager.Finish());
+  EXPECT_EQ(document.FindByTag(Tag::kP).size(), 2);
+
+  DOMManager parsed(kDocument);
+  parsed.Freeze();
+  EXPECT_TRUE(parsed.IsValid());
+}
+
+TEST(FrozenDocumentTest, ResetDoesNotChangeTheView) {
+  DOMManager manager("<p>one</p>");
+  const FrozenDocument document = manager.Freeze();
+  EXPECT_FALSE(manager.Reset("<span>two</span>"));
+  EXPECT_EQ(document.FindByTag(Tag::kP).size(), 1);
+  EXPECT_EQ(document.FindByTag(Tag::kSpan).size(), 0);
+  EXPECT_EQ(document.root()->first_child()->As<TagNode>()->text_content(), "one");
+  EXPECT_TRUE(manager.IsValid());
+
+  // Streamed documents cannot be reset either, frozen or not
+  DOMManager streamed;
+  EXPECT_TRUE(streamed.Feed("<p>one</p>"));
+  EXPECT_FALSE(streamed.Reset("<span>two</span>"));
+  EXPECT_TRUE(streamed.Finish());
+  EXPECT_EQ(streamed.dom_indexer().FindByTag(Tag::kP).size(), 1);
+  streamed.Freeze();
+  EXPECT_FALSE(streamed.Reset("<span>two</span>"));
+  EXPECT_EQ(streamed.dom_indexer().FindByTag(Tag::kSpan).size(), 0);
+}
+
+TEST(FrozenDocumentTest, ServesQueriesFromManyThreads) {
+  const std::string html = Catalog(2000);
+  DOMManager manager(html);
+  ASSERT_TRUE(manager.IsValid());
+  const FrozenDocument document = manager.Freeze();
+
+  std::vector<Query> queries;
+  for (std::string_view selectors : {"li.product.sale > h2", "#catalog a[href]", "li + li p", "#p1234 ~ li"}) {
+    std::optional<Query> query = Query::Compile(selectors);
+    ASSERT_TRUE(query.has_value()) << selectors;
+    queries.push_back(std::move(*query));
+  }
+  const Answers expected = Answer(document, queries);
+  ASSERT_EQ(expected.selected[0].size(), 667);
+
+  constexpr int kThreads = 8;
+  std::vector<Answers> answers(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([document, &queries, &answers, i] {
+      for (int round = 0; round < 4; ++round) {
+        answers[i] = Answer(document, queries);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const Answers& answer : answers) {
+    EXPECT_EQ(answer, expected);
+  }
+}
+
+}  // namespace arboris
@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -36,6 +37,32 @@ constexpr std::string_view kEmptyTagName = "<>content</>";
 constexpr std::string_view kIncompleteTag = "<div";
 constexpr std::string_view kPositionTest = "<p>test</p>";
 constexpr std::string_view kWhitespaceTest = "<  div  >  content  </  div  >";
+constexpr std::string_view kStreamDocument =
+    "<!DOCTYPE html><html><head><script>if (a </b) {}</script></head>"
+    "<body class=\"x y\" id=main><p>Hello<br/>World</p><!-- note --></body></html>";
+
+// One line per token, so token streams of different parses can be compared
+void TraceTokens(HtmlTokenParser& parser, std::vector<std::string>* trace) {
+  parser.set_feed_open_token_callback([trace](HtmlToken&& token, const char*) {
+    std::string line = "open " + std::to_string(static_cast<int>(token.tag)) + " " + std::to_string(token.begin_pos) +
+                       "-" + std::to_string(token.end_pos);
+    for (const auto& attribute : token.attributes) {
+      line += " " + std::string(attribute.name) + "=" + std::string(attribute.value);
+    }
+    trace->push_back(std::move(line));
+    return true;
+  });
+  parser.set_feed_text_token_callback([trace](HtmlTextToken&& token) {
+    trace->push_back("text " + std::string(token.text_content) + " " + std::to_string(token.begin_pos) + "-" +
+                    std::to_string(token.end_pos));
+    return true;
+  });
+  parser.set_feed_close_token_callback([trace](HtmlCloseToken&& token, const char*) {
+    trace->push_back("close " + std::to_string(static_cast<int>(token.tag)) + " " + std::to_string(token.begin_pos) +
+                    "-" + std::to_string(token.end_pos));
+    return true;
+  });
+}
 
 }  // anonymous namespace
 
@@ -99,12 +126,9 @@ TEST_F(HtmlTagProviderTest, ParseTextOnly) {
 
   SetupTokenCollectors(parser, tokens);
 
-  // TODO(Team): Discuss with team about returning false for text-only content
-  // Text-only content always causes Parse() to return false
-  // because FindNextChar returns npos when '<' is not found
-  EXPECT_FALSE(parser.Parse());
+  // Text runs to the end of the content when no '<' follows
+  EXPECT_TRUE(parser.Parse());
 
-  // Even though parsing fails, text token should still be created
   EXPECT_TRUE(tokens.open_tokens.empty());
   EXPECT_EQ(tokens.text_tokens.size(), 1);
   EXPECT_TRUE(tokens.close_tokens.empty());
@@ -243,11 +267,260 @@ TEST_F(HtmlTagProviderTest, ParseTagWithAttributes) {
   EXPECT_EQ(tokens.text_tokens[0].text_content, "content");
   EXPECT_EQ(tokens.close_tokens[0].tag, Tag::kDiv);
 
-  // TODO(Team): Add comprehensive attribute parsing tests
-  // - Test attribute extraction and validation
-  // - Test multiple attributes with different formats
-  // - Test attribute values with quotes (single/double)
-  // - Test malformed attributes handling
+  // Attribute extraction
+  const HtmlToken& div = tokens.open_tokens[0];
+  ASSERT_EQ(div.attributes.size(), 2);
+  EXPECT_EQ(div.attributes[0].name, "class");
+  EXPECT_EQ(div.attributes[0].value, "test");
+  EXPECT_EQ(div.attributes[1].name, "id");
+  EXPECT_EQ(div.attributes[1].value, "main");
+  EXPECT_EQ(div.id, "main");
+  EXPECT_EQ(div.classes.raw(), "test");
+  EXPECT_EQ(div.end_pos, 28);
+}
+
+TEST_F(HtmlTagProviderTest, ParseAttributeFormats) {
+  constexpr std::string_view kHtml =
+      "<input type=\"text\" name='q' value=plain disabled data-x = \"spaced\" empty=\"\"><p>t</p>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 2);
+
+  const HtmlToken& input = tokens.open_tokens[0];
+  EXPECT_EQ(input.tag, Tag::kInput);
+  ASSERT_EQ(input.attributes.size(), 6);
+  EXPECT_EQ(input.attributes[0].value, "text");     // double quotes
+  EXPECT_EQ(input.attributes[1].value, "q");        // single quotes
+  EXPECT_EQ(input.attributes[2].value, "plain");    // unquoted
+  EXPECT_EQ(input.attributes[3].name, "disabled");  // boolean
+  EXPECT_TRUE(input.attributes[3].value.empty());
+  EXPECT_EQ(input.attributes[4].name, "data-x");  // whitespace around '='
+  EXPECT_EQ(input.attributes[4].value, "spaced");
+  EXPECT_EQ(input.attributes[5].name, "empty");
+  EXPECT_TRUE(input.attributes[5].value.empty());
+  EXPECT_TRUE(input.classes.empty());
+}
+
+TEST_F(HtmlTagProviderTest, ParseAttributeValueWithMarkupCharacters) {
+  constexpr std::string_view kHtml = "<a href=\"/x?a=1&b=2\" title='1 > 0 \"quoted\"'>link</a>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 1);
+  ASSERT_EQ(tokens.text_tokens.size(), 1);
+
+  // '>' and the other quote kind inside a quoted value do not end the tag
+  EXPECT_EQ(tokens.open_tokens[0].FindAttribute("href")->value, "/x?a=1&b=2");
+  EXPECT_EQ(tokens.open_tokens[0].FindAttribute("title")->value, "1 > 0 \"quoted\"");
+  EXPECT_EQ(tokens.text_tokens[0].text_content, "link");
+}
+
+TEST_F(HtmlTagProviderTest, ParseIdAndClasses) {
+  constexpr std::string_view kHtml = "<DIV ID=top Class=\"  card  card--wide\tactive \" id=second></DIV>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 1);
+
+  const HtmlToken& div = tokens.open_tokens[0];
+  // Attribute names match case-insensitively and duplicates keep the first value
+  EXPECT_EQ(div.id, "top");
+  EXPECT_EQ(div.attributes.size(), 2);
+  EXPECT_EQ(div.FindAttribute("class"), &div.attributes[1]);
+  EXPECT_EQ(div.FindAttribute("missing"), nullptr);
+
+  std::vector<std::string_view> classes(div.classes.begin(), div.classes.end());
+  const std::vector<std::string_view> expected = {"card", "card--wide", "active"};
+  EXPECT_EQ(classes, expected);
+  EXPECT_TRUE(div.classes.Contains("card--wide"));
+  EXPECT_FALSE(div.classes.Contains("card--"));
+}
+
+TEST_F(HtmlTagProviderTest, ParseSelfClosingSyntax) {
+  constexpr std::string_view kHtml = "<img src=a.png/><br/><img src=\"b.png\" />";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 3);
+
+  // An unquoted value runs up to whitespace or '>', so the '/' belongs to it
+  EXPECT_EQ(tokens.open_tokens[0].FindAttribute("src")->value, "a.png/");
+  EXPECT_TRUE(tokens.open_tokens[1].attributes.empty());
+  EXPECT_EQ(tokens.open_tokens[2].FindAttribute("src")->value, "b.png");
+}
+
+TEST_F(HtmlTagProviderTest, ParseMalformedAttributes) {
+  auto string_pool = std::make_shared<StringPool>(1024);
+
+  // Unterminated quoted value
+  HtmlTokenParser unterminated("<div class=\"open>text</div>", string_pool);
+  EXPECT_FALSE(unterminated.Parse());
+
+  // Missing '>' after attributes
+  HtmlTokenParser missing_end("<div id=x", string_pool);
+  EXPECT_FALSE(missing_end.Parse());
+
+  // '=' without a value before '>'
+  HtmlTokenParser missing_value("<div id=></div>", string_pool);
+  TokenCollectors tokens;
+  SetupTokenCollectors(missing_value, tokens);
+  EXPECT_TRUE(missing_value.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 1);
+  EXPECT_TRUE(tokens.open_tokens[0].id.empty());
+}
+
+TEST_F(HtmlTagProviderTest, ParseRawTextElements) {
+  constexpr std::string_view kHtml =
+      "<script>if (a<b && s == \"</div>\") { x = '<p>'; }</scripts></SCRIPT >"
+      "<style>a > b { content: '<'; }</style><textarea><b>bold</b></textarea/><title></title>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 4);
+  ASSERT_EQ(tokens.close_tokens.size(), 4);
+
+  // Markup inside the element is text, and "</scripts" does not end a script. An empty element has no text token.
+  ASSERT_EQ(tokens.text_tokens.size(), 3);
+  EXPECT_EQ(tokens.text_tokens[0].text_content, "if (a<b && s == \"</div>\") { x = '<p>'; }</scripts>");
+  EXPECT_EQ(tokens.text_tokens[1].text_content, "a > b { content: '<'; }");
+  EXPECT_EQ(tokens.text_tokens[2].text_content, "<b>bold</b>");
+  EXPECT_EQ(tokens.close_tokens[0].tag, Tag::kScript);
+  EXPECT_EQ(tokens.close_tokens[3].tag, Tag::kTitle);
+}
+
+TEST_F(HtmlTagProviderTest, ParseUnterminatedRawText) {
+  constexpr std::string_view kHtml = "<script>let s = '<div>';";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  // Without an end tag the script runs to the end of the input
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.text_tokens.size(), 1);
+  EXPECT_EQ(tokens.text_tokens[0].text_content, "let s = '<div>';");
+  EXPECT_TRUE(tokens.close_tokens.empty());
+}
+
+TEST_F(HtmlTagProviderTest, ParseMarkupDeclarations) {
+  constexpr std::string_view kHtml =
+      "<!DOCTYPE html><?xml version=\"1.0\"?><!--[if IE]><p>old</p><![endif]--><!----><!-->"
+      "<p><![CDATA[a<b>]]></p><!bogus>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+  std::vector<HtmlMarkupToken> markup_tokens;
+
+  SetupTokenCollectors(parser, tokens);
+  parser.set_feed_markup_token_callback([&markup_tokens](HtmlMarkupToken&& token) {
+    markup_tokens.push_back(token);
+    return true;
+  });
+
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 1);
+  EXPECT_EQ(tokens.open_tokens[0].tag, Tag::kP);
+  EXPECT_TRUE(tokens.text_tokens.empty());
+
+  ASSERT_EQ(markup_tokens.size(), 7);
+  EXPECT_EQ(markup_tokens[0].kind, HtmlMarkupKind::kDoctype);
+  EXPECT_EQ(markup_tokens[0].content, "html");
+  EXPECT_EQ(markup_tokens[1].kind, HtmlMarkupKind::kProcessingInstruction);
+  EXPECT_EQ(markup_tokens[1].content, "xml version=\"1.0\"");
+  EXPECT_EQ(markup_tokens[2].kind, HtmlMarkupKind::kComment);
+  EXPECT_EQ(markup_tokens[2].content, "[if IE]><p>old</p><![endif]");
+  EXPECT_TRUE(markup_tokens[3].content.empty());
+  EXPECT_TRUE(markup_tokens[4].content.empty());
+  EXPECT_EQ(markup_tokens[4].end_pos - markup_tokens[4].begin_pos, 5);
+  EXPECT_EQ(markup_tokens[5].kind, HtmlMarkupKind::kCdata);
+  EXPECT_EQ(markup_tokens[5].content, "a<b>");
+  EXPECT_EQ(markup_tokens[6].kind, HtmlMarkupKind::kComment);
+  EXPECT_EQ(markup_tokens[6].content, "bogus");
+}
+
+TEST_F(HtmlTagProviderTest, ParseSkipsMarkupWithoutCallback) {
+  constexpr std::string_view kHtml = "<!doctype html><!-- <div> a > b --><p>text</p><!-- unterminated <p>";
+  auto string_pool = std::make_shared<StringPool>(1024);
+  HtmlTokenParser parser(kHtml, string_pool);
+  TokenCollectors tokens;
+
+  SetupTokenCollectors(parser, tokens);
+
+  // Skipped markup is neither reported nor copied into the pool; an unterminated comment runs to the end
+  const char* pool_begin = string_pool->GetCursor();
+  EXPECT_TRUE(parser.Parse());
+  ASSERT_EQ(tokens.open_tokens.size(), 1);
+  ASSERT_EQ(tokens.text_tokens.size(), 1);
+  EXPECT_EQ(tokens.text_tokens[0].text_content, "text");
+  EXPECT_EQ(string_pool->GetCursor() - pool_begin, 4);
+}
+
+namespace {
+
+// Statically bound sink without a markup handler, counting tokens and stopping at the first <b>
+struct CountingSink {
+  int open_count = 0;
+  int text_count = 0;
+  int close_count = 0;
+
+  bool FeedOpenToken(HtmlToken&& token, const char*) {
+    ++open_count;
+    return token.tag != Tag::kB;
+  }
+
+  bool FeedTextToken(HtmlTextToken&&) {
+    ++text_count;
+    return true;
+  }
+
+  bool FeedCloseToken(HtmlCloseToken&&, const char*) {
+    ++close_count;
+    return true;
+  }
+};
+
+static_assert(HtmlTokenSink<CountingSink>);
+static_assert(!HtmlMarkupTokenSink<CountingSink>);
+
+}  // anonymous namespace
+
+TEST_F(HtmlTagProviderTest, ParseWithStaticSink) {
+  auto string_pool = std::make_shared<StringPool>(1024);
+  BasicHtmlTokenParser<CountingSink> parser("<!DOCTYPE html><div><p>text</p><!-- note --></div>", string_pool);
+
+  EXPECT_TRUE(parser.Parse());
+  EXPECT_EQ(parser.sink().open_count, 2);
+  EXPECT_EQ(parser.sink().text_count, 1);
+  EXPECT_EQ(parser.sink().close_count, 2);
+
+  // A sink returning false aborts the parse
+  BasicHtmlTokenParser<CountingSink> aborted("<p>a<b>b</b>c</p>", string_pool);
+  EXPECT_FALSE(aborted.Parse());
+  EXPECT_EQ(aborted.sink().open_count, 2);
+  EXPECT_EQ(aborted.sink().text_count, 1);
+  EXPECT_EQ(aborted.sink().close_count, 0);
 }
 
 TEST_F(HtmlTagProviderTest, ParseComplexHtml) {
@@ -310,11 +583,9 @@ TEST_F(HtmlTagProviderTest, ParseMalformedTagUnclosedTag) {
 
   SetupTokenCollectors(parser, tokens);
 
-  // Unclosed tag with trailing text always causes Parse() to return false
-  // because FindNextChar returns npos when no more '<' is found after the text
-  EXPECT_FALSE(parser.Parse());
+  // Tokenizing succeeds; the missing close tag is left to the DOM builder
+  EXPECT_TRUE(parser.Parse());
 
-  // Even though parsing fails, tokens should still be created
   EXPECT_EQ(tokens.open_tokens.size(), 1);   // <div> tag parsed
   EXPECT_EQ(tokens.text_tokens.size(), 1);   // "content" text parsed
   EXPECT_TRUE(tokens.close_tokens.empty());  // no closing tag
@@ -556,4 +827,120 @@ TEST_F(HtmlTagProviderTest, ParseNestedTagsWithMixedText) {
   EXPECT_EQ(tokens.close_tokens[1].end_pos, 31);
 }
 
+/**
+ * Test chunked parsing
+ */
+TEST_F(HtmlTagProviderTest, ParseChunkDefersIncompleteTokens) {
+  HtmlTokenParser parser(std::string_view{}, nullptr);
+  std::vector<std::string> trace;
+  TraceTokens(parser, &trace);
+
+  // Trailing text may continue in the next chunk, so only the open tag is emitted
+  EXPECT_TRUE(parser.ParseChunk("<p>Hel", false));
+  EXPECT_EQ(parser.consumed(), 3);
+  ASSERT_EQ(trace.size(), 1);
+
+  // The next chunk starts with the unconsumed bytes; positions count from the start of the document
+  EXPECT_TRUE(parser.ParseChunk("Hello</p", false));
+  EXPECT_EQ(parser.consumed(), 5);
+  ASSERT_EQ(trace.size(), 2);
+  EXPECT_EQ(trace[1], "text Hello 3-8");
+
+  EXPECT_TRUE(parser.ParseChunk("</p>", true));
+  ASSERT_EQ(trace.size(), 3);
+  EXPECT_EQ(trace[2], "close " + std::to_string(static_cast<int>(Tag::kP)) + " 8-12");
+}
+
+TEST_F(HtmlTagProviderTest, ParseChunkMatchesWholeDocumentAtEverySplit) {
+  HtmlTokenParser whole_parser(kStreamDocument, nullptr);
+  std::vector<std::string> expected;
+  TraceTokens(whole_parser, &expected);
+  ASSERT_TRUE(whole_parser.Parse());
+
+  for (std::size_t split = 0; split <= kStreamDocument.length(); ++split) {
+    HtmlTokenParser parser(std::string_view{}, nullptr);
+    std::vector<std::string> trace;
+    TraceTokens(parser, &trace);
+
+    const std::string_view first = kStreamDocument.substr(0, split);
+    ASSERT_TRUE(parser.ParseChunk(first, false)) << "split at " << split;
+    const std::string second =
+        std::string(first.substr(parser.consumed())) + std::string(kStreamDocument.substr(split));
+    ASSERT_TRUE(parser.ParseChunk(second, true)) << "split at " << split;
+
+    EXPECT_EQ(trace, expected) << "split at " << split;
+  }
+}
+
+TEST_F(HtmlTagProviderTest, ParseChunkGrownInPlaceMatchesWholeDocument) {
+  constexpr std::string_view kDocument =
+      "<html><head><script>a </scripts> b</script><style>p{}</STYLE></head><body title='a > b'>"
+      "<![CDATA[ ]] ]]><!-- <p> -- --><p>text</p></body></html>";
+  HtmlTokenParser whole_parser(kDocument, nullptr);
+  std::vector<std::string> expected;
+  TraceTokens(whole_parser, &expected);
+  ASSERT_TRUE(whole_parser.Parse());
+
+  // One byte at a time into a buffer that never moves, so every search is cut off and resumed
+  HtmlTokenParser parser(std::string_view{}, nullptr);
+  std::vector<std::string> trace;
+  TraceTokens(parser, &trace);
+  std::string buffer;
+  buffer.reserve(kDocument.length());
+  for (const char c : kDocument) {
+    buffer += c;
+    ASSERT_TRUE(parser.ParseChunk(buffer, false)) << buffer;
+  }
+  ASSERT_TRUE(parser.ParseChunk(buffer, true));
+  EXPECT_EQ(trace, expected);
+}
+
+TEST_F(HtmlTagProviderTest, ParseChunkScansLargeTokensInLinearTime) {
+  // A script, comment, quoted value and text run of megabytes each, full of structural characters
+  std::string script;
+  std::string value;
+  while (script.size() < 4 * 1024 * 1024) {
+    script += "if (a < b && s == \"</scripts>\") { x = '>'; } // <p class=\"y\">\n";
+    value += "a > b = 'c' / d\n";
+  }
+  const std::string comment(1024 * 1024, '-');
+  const std::string document = "<html><body><script>" + script + "</script><!--" + comment + "--><p title=\"" +
+                               value + "\">" + value + "</p></body></html>";
+
+  HtmlTokenParser parser(std::string_view{}, nullptr);
+  std::vector<std::size_t> text_sizes;
+  parser.set_feed_text_token_callback([&text_sizes](HtmlTextToken&& token) {
+    text_sizes.push_back(token.text_content.size());
+    return true;
+  });
+  std::size_t title_size = 0;
+  parser.set_feed_open_token_callback([&title_size](HtmlToken&& token, const char*) {
+    if (const HtmlAttribute* title = token.FindAttribute("title")) {
+      title_size = title->value.size();
+    }
+    return true;
+  });
+
+  // 16 KB chunks appended to a buffer that grows in place, as DOMManager does between its blocks
+  constexpr std::size_t kChunkSize = 16 * 1024;
+  std::string buffer;
+  buffer.reserve(document.size());
+  for (std::size_t pos = 0; pos < document.size(); pos += kChunkSize) {
+    buffer.append(document, pos, kChunkSize);
+    ASSERT_TRUE(parser.ParseChunk(buffer, false));
+  }
+  ASSERT_TRUE(parser.ParseChunk(buffer, true));
+
+  EXPECT_EQ(text_sizes, (std::vector<std::size_t>{script.size(), value.size()}));
+  EXPECT_EQ(title_size, value.size());
+  // Indexing reads each byte once and the end tag and terminator searches little more; rescanning the pending
+  // token from its start would read the 4 MB script about 256 times
+  EXPECT_LT(parser.bytes_scanned(), 3 * document.size());
+}
+
+TEST_F(HtmlTagProviderTest, ParseChunkMalformedInput) {
+  HtmlTokenParser parser(std::string_view{}, nullptr);
+  EXPECT_FALSE(parser.ParseChunk("<p>text<>", false));
+}
+
 }  // namespace arboris
@@ -0,0 +1,77 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "dom/dom_manager.hpp"
+#include "dom/main_content.hpp"
+
+namespace arboris {
+namespace {
+
+const std::string kArticlePage =
+    "<html><head><title>News</title><script>track();</script></head><body>"
+    "<div id=header><div class=menu><a href=/>Home</a> <a href=/world>World</a> <a href=/sport>Sport</a></div></div>"
+    "<div id=wrapper>"
+    "<div class=sidebar><p>Related stories you may have missed this week.</p>"
+    "<ul><li><a href=/1>A related story about something else</a></li>"
+    "<li><a href=/2>Another related story about something else</a></li></ul></div>"
+    "<div class=story-body>"
+    "<h1>Headline</h1>"
+    "<p>The first paragraph of the story explains what happened, where it happened and why it matters.</p>"
+    "<p>The second paragraph adds detail, with a <a href=/source>link to a source</a> in the middle of it.</p>"
+    "<nav><a href=/prev>Previous</a> <a href=/next>Next</a></nav>"
+    "<p>The third paragraph quotes somebody at length about the consequences of the events.</p>"
+    "</div>"
+    "<div class=comments><p>Great article!</p><p>I disagree.</p></div>"
+    "</div>"
+    "<div id=footer><p>Copyright and a long list of legal text that nobody reads at all.</p></div>"
+    "</body></html>";
+
+}  // anonymous namespace
+
+TEST(MainContentTest, PicksTheArticleBody) {
+  for (const bool flat : {false, true}) {
+    DOMManager manager(kArticlePage, {.build_flat_document = flat});
+    const MainContent content = ExtractMainContent(manager);
+    ASSERT_NE(content.node, nullptr);
+    EXPECT_EQ(content.node->classes().raw(), "story-body");
+    EXPECT_GT(content.score, 0.0);
+    EXPECT_EQ(content.text,
+              "Headline\n"
+              "The first paragraph of the story explains what happened, where it happened and why it matters.\n"
+              "The second paragraph adds detail, with a link to a source in the middle of it.\n"
+              "The third paragraph quotes somebody at length about the consequences of the events.");
+  }
+}
+
+TEST(MainContentTest, CandidateTagsAndHints) {
+  // A short paragraph in an article outranks a longer one in a div hinted as a comment section
+  DOMManager manager(
+      "<div class=comment><p>A comment that is a little longer than the article text.</p></div>"
+      "<article><p>The article text, which is short.</p></article>");
+  EXPECT_EQ(ExtractMainContent(manager).node->tag(), Tag::kArticle);
+
+  // Paragraphs outside every candidate score nothing
+  const MainContent content = ExtractMainContent(manager, {.candidate_tags = {Tag::kSection}});
+  EXPECT_EQ(content.node, nullptr);
+  EXPECT_TRUE(content.text.empty());
+}
+
+TEST(MainContentTest, FallsBackToTheInnermostCandidateWithMostText) {
+  DOMManager manager("<div><div><a href=/>menu</a></div><div id=text>Plain text without paragraphs</div></div>");
+  const MainContent content = ExtractMainContent(manager);
+  ASSERT_NE(content.node, nullptr);
+  EXPECT_EQ(content.node->id(), "text");
+  EXPECT_EQ(content.text, "Plain text without paragraphs");
+
+  DOMManager empty("<div><p></p></div>");
+  EXPECT_EQ(ExtractMainContent(empty).node, nullptr);
+}
+
+}  // namespace arboris
@@ -0,0 +1,84 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "query/query.hpp"
+#include "query/query_set.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>Page</title>"
+    "<meta property='og:title' content=title><meta name=Description content=desc>"
+    "</head><body data-page=home>"
+    "<div class=article><p>one <a href=/a>a</a></p><p>two <a href=/b data-x>b</a><img src=i.png></p></div>"
+    "<ul class=nav><li><a href=/c>c</a></li><li><a>no href</a></li></ul>"
+    "</body></html>";
+
+constexpr std::string_view kSelectors[] = {
+    "title",
+    "meta[name=description i]",
+    "meta[property^='og:']",
+    "a[href]",
+    "img[src]",
+    "div.article p",
+    "div.article p a",
+    "div.article > p > a[href]",
+    "ul.nav li a, div.article a",
+    "[data-x], [data-page]",
+    "p + p",
+    "section p",
+};
+
+}  // anonymous namespace
+
+TEST(QuerySetTest, MatchesIndependentQueries) {
+  for (const DOMManagerOptions& options :
+       {DOMManagerOptions{}, DOMManagerOptions{.dom_indexer = {.attributes = {"href", "data-x"},
+                                                                .attribute_values = {"name", "property"}}}}) {
+    DOMManager manager(kDocument, options);
+    const std::optional<QuerySet> query_set = QuerySet::Compile(kSelectors);
+    ASSERT_TRUE(query_set.has_value());
+    ASSERT_EQ(query_set->size(), std::size(kSelectors));
+
+    const std::vector<std::vector<TagNode*>> results = query_set->Select(manager.dom_indexer());
+    ASSERT_EQ(results.size(), std::size(kSelectors));
+    for (std::size_t i = 0; i < std::size(kSelectors); ++i) {
+      EXPECT_EQ(results[i], Query::Compile(kSelectors[i])->Select(manager.dom_indexer())) << kSelectors[i];
+    }
+    EXPECT_EQ(results[3].size(), 3);
+    EXPECT_EQ(results[6].size(), 2);
+    EXPECT_EQ(results[8].size(), 4);
+    EXPECT_EQ(results[9].size(), 2);
+    EXPECT_TRUE(results[11].empty());
+  }
+}
+
+TEST(QuerySetTest, SharesCompoundsAndPrefixes) {
+  const std::optional<QuerySet> query_set =
+      QuerySet::Compile({"div.article p", "div.article p a", "div.article > p", "a", "p a"});
+  ASSERT_TRUE(query_set.has_value());
+  // div.article, p and a
+  EXPECT_EQ(query_set->compound_count(), 3);
+  // div.article, div.article p, div.article p a, div.article > p, a, p, p a
+  EXPECT_EQ(query_set->step_count(), 7);
+}
+
+TEST(QuerySetTest, RejectsInvalidSelectors) {
+  EXPECT_FALSE(QuerySet::Compile({"title", "a:hover"}).has_value());
+  const std::optional<QuerySet> empty = QuerySet::Compile(std::span<const std::string_view>{});
+  ASSERT_TRUE(empty.has_value());
+  DOMManager manager(kDocument);
+  EXPECT_TRUE(empty->Select(manager.dom_indexer()).empty());
+}
+
+}  // namespace arboris
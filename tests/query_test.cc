@@ -0,0 +1,171 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "query/query.hpp"
+#include "query/selector.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head>"
+    "<meta property='og:title' content=title><meta property='og:type' content=article>"
+    "<meta name=Description content=desc><link rel='canonical' href='/home'>"
+    "</head><body>"
+    "<div id=main class='card wide' lang=en-US>"
+    "<p class=lead>one</p><p>two <a href='https://example.com/x' title='Big Link'>link</a></p>"
+    "<ul><li class=first>a</li><li>b</li><li class=last>c</li></ul>"
+    "</div>"
+    "<div class=card><section><p>three</p></section><a name=anchor>no href</a></div>"
+    "</body></html>";
+
+std::vector<std::string_view> Select(const DOMManager& manager, std::string_view selectors) {
+  const std::optional<Query> query = Query::Compile(selectors);
+  EXPECT_TRUE(query.has_value()) << selectors;
+  std::vector<std::string_view> texts;
+  if (query) {
+    for (const TagNode* node : query->Select(manager.dom_indexer())) {
+      texts.push_back(node->text_content());
+    }
+  }
+  return texts;
+}
+
+std::size_t Count(const DOMManager& manager, std::string_view selectors) {
+  return Select(manager, selectors).size();
+}
+
+using Texts = std::vector<std::string_view>;
+
+}  // anonymous namespace
+
+TEST(SelectorTest, ParsesCompoundsAndCombinators) {
+  std::vector<ComplexSelector> selectors;
+  ASSERT_TRUE(ParseSelectorList("  div#main.card.wide[lang|='en' i] > p + ul ~ a  ,li", &selectors));
+  ASSERT_EQ(selectors.size(), 2);
+
+  const ComplexSelector& first = selectors[0];
+  ASSERT_EQ(first.compounds.size(), 4);
+  EXPECT_EQ(first.combinators,
+            (std::vector<Combinator>{Combinator::kChild, Combinator::kNextSibling, Combinator::kSubsequentSibling}));
+  EXPECT_EQ(first.compounds[0].tag, Tag::kDiv);
+  EXPECT_EQ(first.compounds[0].id, "main");
+  EXPECT_EQ(first.compounds[0].classes, (std::vector<std::string>{"card", "wide"}));
+  ASSERT_EQ(first.compounds[0].attributes.size(), 1);
+  EXPECT_EQ(first.compounds[0].attributes[0].name, "lang");
+  EXPECT_EQ(first.compounds[0].attributes[0].op, AttributeOperator::kDashMatch);
+  EXPECT_EQ(first.compounds[0].attributes[0].value, "en");
+  EXPECT_TRUE(first.compounds[0].attributes[0].ignore_case);
+
+  EXPECT_EQ(selectors[1].compounds.size(), 1);
+  EXPECT_EQ(selectors[1].compounds[0].tag, Tag::kLi);
+}
+
+TEST(SelectorTest, RejectsUnsupportedSyntax) {
+  std::vector<ComplexSelector> selectors;
+  EXPECT_FALSE(ParseSelectorList("", &selectors));
+  EXPECT_FALSE(ParseSelectorList("div,", &selectors));
+  EXPECT_FALSE(ParseSelectorList("div >", &selectors));
+  EXPECT_FALSE(ParseSelectorList("a:hover", &selectors));
+  EXPECT_FALSE(ParseSelectorList("a[href", &selectors));
+  EXPECT_FALSE(ParseSelectorList("a[href=\"x]", &selectors));
+  EXPECT_FALSE(ParseSelectorList("a[href!=x]", &selectors));
+  EXPECT_FALSE(ParseSelectorList("my-widget", &selectors));
+  EXPECT_FALSE(Query::Compile("p..lead").has_value());
+}
+
+TEST(QueryTest, TypeClassAndId) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Select(manager, "p"), (Texts{"one", "two link", "three"}));
+  EXPECT_EQ(Select(manager, ".lead"), (Texts{"one"}));
+  EXPECT_EQ(Select(manager, "li.first, li.last"), (Texts{"a", "c"}));
+  EXPECT_EQ(Count(manager, "#main"), 1);
+  EXPECT_EQ(Count(manager, "div#main.card.wide"), 1);
+  EXPECT_EQ(Count(manager, "section#main"), 0);
+  EXPECT_EQ(Count(manager, "*"), manager.dom_indexer().elements().size());
+}
+
+TEST(QueryTest, AttributeOperators) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Count(manager, "meta[property^='og:']"), 2);
+  EXPECT_EQ(Select(manager, "a[href]"), (Texts{"link"}));
+  EXPECT_EQ(Count(manager, "a[name]"), 1);
+  EXPECT_EQ(Count(manager, "link[rel=canonical]"), 1);
+  EXPECT_EQ(Count(manager, "[content=article]"), 1);
+  EXPECT_EQ(Count(manager, "a[href$='/x']"), 1);
+  EXPECT_EQ(Count(manager, "a[href*=example]"), 1);
+  EXPECT_EQ(Count(manager, "a[title~=Link]"), 1);
+  EXPECT_EQ(Count(manager, "a[title~=Lin]"), 0);
+  EXPECT_EQ(Count(manager, "div[lang|=en]"), 1);
+  EXPECT_EQ(Count(manager, "div[lang|=en-u]"), 0);
+
+  // Values are case-sensitive unless the i flag is given; attribute names never are
+  EXPECT_EQ(Count(manager, "meta[name=description]"), 0);
+  EXPECT_EQ(Count(manager, "meta[name=description i]"), 1);
+  EXPECT_EQ(Count(manager, "meta[NAME='DESCRIPTION' i]"), 1);
+  EXPECT_EQ(Count(manager, "a[title*=big i]"), 1);
+  EXPECT_EQ(Count(manager, "div[lang|=EN i]"), 1);
+
+  // An empty value never matches a substring operator
+  EXPECT_EQ(Count(manager, "a[href^='']"), 0);
+}
+
+TEST(QueryTest, AttributeIndexesGiveTheSameResults) {
+  DOMManager plain(kDocument);
+  DOMManager indexed(kDocument, {.dom_indexer = {.attributes = {"href", "title"},
+                                                 .attribute_values = {"property", "name", "rel", "lang"}}});
+  for (std::string_view selectors :
+       {"meta[property^='og:']", "meta[property^='OG:' i]", "a[href]", "[href]", "a[name]", "meta[name=description]",
+        "meta[NAME='DESCRIPTION' i]", "link[rel=canonical][href]", "a[href*=example]", "a[title~=Link]",
+        "div[lang|=en]", "div[lang=en-us i] a[href]", "[property$=type]", "a[href^='']"}) {
+    EXPECT_EQ(Select(indexed, selectors), Select(plain, selectors)) << selectors;
+  }
+}
+
+TEST(QueryTest, DescendantAndChildCombinators) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Select(manager, "div p"), (Texts{"one", "two link", "three"}));
+  EXPECT_EQ(Select(manager, "div > p"), (Texts{"one", "two link"}));
+  EXPECT_EQ(Select(manager, "body div section p"), (Texts{"three"}));
+  EXPECT_EQ(Select(manager, "#main a"), (Texts{"link"}));
+  EXPECT_EQ(Select(manager, ".card > a"), (Texts{"no href"}));
+  EXPECT_EQ(Count(manager, "section div"), 0);
+  EXPECT_EQ(Count(manager, "ul li"), 3);
+  EXPECT_EQ(Count(manager, "p > li"), 0);
+}
+
+TEST(QueryTest, NestedAncestorsInTheSameList) {
+  // The closest div before the span does not contain it, an enclosing one does
+  DOMManager manager("<div class=outer><div>inner</div><span>s</span></div><span>out</span>");
+  EXPECT_EQ(Select(manager, "div span"), (Texts{"s"}));
+  EXPECT_EQ(Select(manager, "div div"), (Texts{"inner"}));
+}
+
+TEST(QueryTest, SiblingCombinators) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Select(manager, "li.first + li"), (Texts{"b"}));
+  EXPECT_EQ(Select(manager, "li.first ~ li"), (Texts{"b", "c"}));
+  EXPECT_EQ(Select(manager, "li + li.first"), (Texts{}));
+  // Text between elements does not break adjacency
+  EXPECT_EQ(Select(manager, "p.lead + p"), (Texts{"two link"}));
+  EXPECT_EQ(Count(manager, "section + a"), 1);
+  EXPECT_EQ(Count(manager, "div ~ div"), 1);
+  EXPECT_EQ(Count(manager, "meta ~ link"), 1);
+}
+
+TEST(QueryTest, SelectorListsAreMergedInDocumentOrder) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Select(manager, "li.last, p.lead, li, .lead"), (Texts{"one", "a", "b", "c"}));
+}
+
+}  // namespace arboris
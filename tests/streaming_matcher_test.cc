@@ -0,0 +1,131 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "query/query_set.hpp"
+#include "query/streaming_matcher.hpp"
+#include "utils/string_pool.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>Page</title>"
+    "<meta property='og:title' content=title><meta name=Description content=desc>"
+    "<link rel=canonical href=/home>"
+    "</head><body>"
+    "<div class=article><p>one <a href=/a>a</a></p><p>two <a href=/b>b</a><img src=i.png></p></div>"
+    "<ul class=nav><li><a href=/c>c</a></li><li><a>no href</a></li><li class=last>z</li></ul>"
+    "</body></html>";
+
+constexpr std::string_view kSelectors[] = {
+    "title",
+    "meta[name=description i], link[rel=canonical]",
+    "a[href]",
+    "div.article p > a",
+    "li + li",
+    "p ~ p",
+    "img[src], div.article img",
+    "ul.nav > li a[href]",
+};
+
+struct Match {
+  std::size_t query;
+  Tag tag;
+  std::string href;
+  std::string text;
+
+  bool operator==(const Match& other) const = default;
+};
+
+// Matches grouped by query, each group in document order of the elements' close tokens
+std::vector<std::vector<Match>> StreamMatches(std::string_view document, bool with_pool) {
+  std::vector<std::vector<Match>> matches(std::size(kSelectors));
+  std::optional<StreamingMatcher> matcher = StreamingMatcher::Compile(kSelectors, [&](const StreamMatch& match) {
+    const HtmlAttribute* href = match.element->FindAttribute("href");
+    matches[match.query].push_back({match.query, match.element->tag,
+                                    href == nullptr ? std::string{} : std::string(href->value),
+                                    std::string(match.text)});
+  });
+  EXPECT_TRUE(matcher.has_value());
+
+  auto pool = with_pool ? std::make_shared<StringPool>(document.size()) : nullptr;
+  StreamingMatchParser parser(document, pool, std::move(*matcher));
+  EXPECT_TRUE(parser.Parse());
+  EXPECT_EQ(parser.sink().depth(), 0);
+  return matches;
+}
+
+}  // anonymous namespace
+
+TEST(StreamingMatcherTest, MatchesLikeTheDOMQueries) {
+  const std::vector<std::vector<Match>> matches = StreamMatches(kDocument, false);
+
+  DOMManager manager(kDocument, {.zero_copy_text = true});
+  const std::vector<std::vector<TagNode*>> expected = QuerySet::Compile(kSelectors)->Select(manager.dom_indexer());
+  for (std::size_t query = 0; query < std::size(kSelectors); ++query) {
+    // Matches are reported at close, so an element closes after its descendants; these selectors never match
+    // both an element and its descendant, so close order is document order
+    ASSERT_EQ(matches[query].size(), expected[query].size()) << kSelectors[query];
+    for (std::size_t i = 0; i < expected[query].size(); ++i) {
+      EXPECT_EQ(matches[query][i].tag, expected[query][i]->tag()) << kSelectors[query];
+      EXPECT_EQ(matches[query][i].text, expected[query][i]->text_content()) << kSelectors[query];
+    }
+  }
+}
+
+TEST(StreamingMatcherTest, ReportsAttributesAndText) {
+  const std::vector<std::vector<Match>> raw = StreamMatches(kDocument, false);
+  EXPECT_EQ(raw[0], (std::vector<Match>{{0, Tag::kTitle, "", "Page"}}));
+  ASSERT_EQ(raw[1].size(), 2);
+  EXPECT_EQ(raw[1][1], (Match{1, Tag::kLink, "/home", ""}));
+  EXPECT_EQ(raw[2], (std::vector<Match>{{2, Tag::kA, "/a", "a"}, {2, Tag::kA, "/b", "b"}, {2, Tag::kA, "/c", "c"}}));
+  EXPECT_EQ(raw[7], (std::vector<Match>{{7, Tag::kA, "/c", "c"}}));
+  // Without a pool the text of an element is its source
+  ASSERT_EQ(raw[4].size(), 2);
+  EXPECT_EQ(raw[4][0].text, "<a>no href</a>");
+
+  // With one it is the concatenated text
+  const std::vector<std::vector<Match>> pooled = StreamMatches(kDocument, true);
+  ASSERT_EQ(pooled[4].size(), 2);
+  EXPECT_EQ(pooled[4][0].text, "no href");
+  EXPECT_EQ(pooled[5].size(), 1);
+  EXPECT_EQ(pooled[5][0].text, "two b");
+}
+
+TEST(StreamingMatcherTest, MatchesEveryRepetition) {
+  std::string document;
+  for (int i = 0; i < 1000; ++i) {
+    document += "<div><p><a href=/x>x</a></p></div>";
+  }
+  std::size_t links = 0;
+  std::optional<StreamingMatcher> matcher = StreamingMatcher::Compile({"div > p a[href]"}, [&](const StreamMatch&) {
+    ++links;
+  });
+  ASSERT_TRUE(matcher.has_value());
+  StreamingMatchParser parser(document, nullptr, std::move(*matcher));
+  EXPECT_TRUE(parser.Parse());
+  EXPECT_EQ(links, 1000);
+  EXPECT_EQ(parser.sink().depth(), 0);
+}
+
+TEST(StreamingMatcherTest, FailsOnMismatchedCloseTags) {
+  std::optional<StreamingMatcher> matcher = StreamingMatcher::Compile({"p"}, nullptr);
+  ASSERT_TRUE(matcher.has_value());
+  StreamingMatchParser parser("<div><p>x</div>", nullptr, std::move(*matcher));
+  EXPECT_FALSE(parser.Parse());
+  EXPECT_FALSE(StreamingMatcher::Compile({"p", "a["}, nullptr).has_value());
+}
+
+}  // namespace arboris
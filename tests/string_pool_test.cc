@@ -0,0 +1,63 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/string_pool.hpp"
+
+namespace arboris {
+
+TEST(StringPoolTest, AppendsWithinFirstBlockAreContiguous) {
+  StringPool pool(16);
+  const char* begin = pool.GetCursor();
+  const std::string_view first = pool.Append("hello ");
+  const std::string_view second = pool.Append("world");
+
+  EXPECT_EQ(first.data(), begin);
+  EXPECT_EQ(second.data(), begin + first.size());
+  EXPECT_EQ(std::string_view(begin, pool.GetCursor()), "hello world");
+  EXPECT_EQ(pool.bytes_used(), 11);
+}
+
+TEST(StringPoolTest, ViewsSurviveGrowth) {
+  // Appending far past the first block must not move earlier strings
+  StringPool pool(8, 64);
+  std::vector<std::string_view> views;
+  for (int i = 0; i < 1000; ++i) {
+    views.push_back(pool.Append("string number " + std::to_string(i)));
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(views[i], "string number " + std::to_string(i));
+  }
+  EXPECT_GE(pool.bytes_reserved(), pool.bytes_used());
+}
+
+TEST(StringPoolTest, ResetReusesBlocks) {
+  StringPool pool(32);
+  const char* begin = pool.GetCursor();
+  ASSERT_EQ(pool.Append("first document").data(), begin);
+  const std::size_t reserved = pool.bytes_reserved();
+
+  pool.Reset();
+  EXPECT_EQ(pool.bytes_used(), 0);
+  EXPECT_EQ(pool.Append("second").data(), begin);
+  EXPECT_EQ(pool.bytes_reserved(), reserved);
+}
+
+TEST(StringPoolTest, HugePageBlocksAreAligned) {
+  StringPool pool(Arena::kHugePageSize + 1, Arena::kDefaultBlockSize, true);
+  const auto address = reinterpret_cast<std::uintptr_t>(pool.GetCursor());
+  EXPECT_EQ(address % Arena::kHugePageSize, 0);
+  EXPECT_EQ(pool.bytes_reserved(), 2 * Arena::kHugePageSize);
+  EXPECT_EQ(pool.Append("text"), "text");
+}
+
+}  // namespace arboris
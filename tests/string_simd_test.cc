@@ -0,0 +1,217 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string/string.hpp"
+#include "string/string_kernels.hpp"
+#include "utils/simd.hpp"
+
+namespace arboris {
+namespace {
+
+// Alphabets biased towards the bytes the tokenizer searches for, so that matches land in every lane
+constexpr std::string_view kMarkupAlphabet = "<>/=\"' \t\n\r\v\fabcdefXYZ019";
+constexpr std::string_view kTargetAlphabet = "<>/=\"' \tabz\n";
+
+struct LevelName {
+  SimdLevel level;
+  const char* name;
+};
+
+constexpr LevelName kVectorLevels[] = {
+    {SimdLevel::kSse42, "sse4.2"},
+    {SimdLevel::kAvx2, "avx2"},
+    {SimdLevel::kAvx512, "avx512"},
+    {SimdLevel::kNeon, "neon"},
+};
+
+std::string RandomString(std::mt19937* rng, std::size_t length, std::string_view alphabet) {
+  std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+  std::string result(length, '\0');
+  for (auto& c : result) {
+    c = alphabet[pick(*rng)];
+  }
+  return result;
+}
+
+std::string RandomBytes(std::mt19937* rng, std::size_t length) {
+  std::uniform_int_distribution<int> pick(0, 255);
+  std::string result(length, '\0');
+  for (auto& c : result) {
+    c = static_cast<char>(pick(*rng));
+  }
+  return result;
+}
+
+}  // anonymous namespace
+
+class StringSimdTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (const auto& entry : kVectorLevels) {
+      if (const StringKernels* kernels = GetStringKernels(entry.level)) {
+        levels_.push_back({entry.name, kernels});
+      }
+    }
+  }
+
+  // Compare every available kernel table against the scalar reference at every start position
+  void ExpectSameAsScalar(std::string_view content, std::string_view targets) {
+    for (const auto& [name, kernels] : levels_) {
+      for (std::size_t begin = 0; begin <= content.size() + 1; ++begin) {
+        ASSERT_EQ(kernels->skip_whitespace(content, begin), scalar::SkipWhitespace(content, begin))
+            << name << " SkipWhitespace begin=" << begin;
+        ASSERT_EQ(kernels->find_next_char(content, begin, targets.front()),
+                  scalar::FindNextChar(content, begin, targets.front()))
+            << name << " FindNextChar begin=" << begin;
+        ASSERT_EQ(kernels->find_next_any_char(content, begin, targets),
+                  scalar::FindNextAnyChar(content, begin, targets))
+            << name << " FindNextAnyChar begin=" << begin;
+        ASSERT_EQ(kernels->find_ignore_ascii_case(content, begin, targets),
+                  scalar::FindIgnoreAsciiCase(content, begin, targets))
+            << name << " FindIgnoreAsciiCase begin=" << begin;
+      }
+      ASSERT_EQ(CollapseWith(*kernels, content), CollapseWith(kScalarStringKernels, content))
+          << name << " CollapseWhitespace";
+      ASSERT_EQ(IndexWith(*kernels, content), IndexWith(kScalarStringKernels, content)) << name << " IndexStructurals";
+    }
+  }
+
+  static std::vector<std::uint32_t> IndexWith(const StringKernels& kernels, std::string_view content) {
+    std::vector<std::uint32_t> positions(content.size());
+    positions.resize(kernels.index_structurals(content, positions.data()));
+    return positions;
+  }
+
+  static std::string CollapseWith(const StringKernels& kernels, std::string_view content) {
+    std::string out(content.size(), '\0');
+    out.resize(kernels.collapse_whitespace(content, out.data()));
+    return out;
+  }
+
+  std::vector<std::pair<const char*, const StringKernels*>> levels_;
+};
+
+TEST_F(StringSimdTest, ScalarAlwaysAvailable) {
+  EXPECT_NE(GetStringKernels(SimdLevel::kScalar), nullptr);
+  EXPECT_TRUE(IsSimdLevelSupported(DetectSimdLevel()));
+  EXPECT_NE(GetStringKernels(DetectSimdLevel()), nullptr);
+}
+
+TEST_F(StringSimdTest, ActiveKernelsMatchDetectedLevel) {
+  EXPECT_EQ(&ActiveStringKernels(), GetStringKernels(DetectSimdLevel()));
+}
+
+TEST_F(StringSimdTest, RandomMarkupMatchesScalar) {
+  std::mt19937 rng(42);
+  for (std::size_t length = 0; length <= 200; ++length) {
+    const std::string content = RandomString(&rng, length, kMarkupAlphabet);
+    const std::string targets = RandomString(&rng, 1 + length % 8, kTargetAlphabet);
+    ExpectSameAsScalar(content, targets);
+  }
+}
+
+TEST_F(StringSimdTest, RandomBytesMatchScalar) {
+  std::mt19937 rng(7);
+  for (std::size_t length = 0; length <= 160; length += 3) {
+    const std::string content = RandomBytes(&rng, length);
+    ExpectSameAsScalar(content, RandomBytes(&rng, 1 + length % 5));
+  }
+}
+
+TEST_F(StringSimdTest, LongRunsMatchScalar) {
+  // Long whitespace runs and long runs without a match cross many vector blocks
+  std::string content(300, ' ');
+  content += "\t\n\r\v\f";
+  content += std::string(300, 'x');
+  content += "<tag attr='value'>";
+  ExpectSameAsScalar(content, " />\t\n\r>");
+  ExpectSameAsScalar(content, "<");
+}
+
+TEST_F(StringSimdTest, LargeTargetSetsMatchScalar) {
+  std::mt19937 rng(1234);
+  const std::string content = RandomBytes(&rng, 130);
+
+  // More targets than fit in one SSE register
+  ExpectSameAsScalar(content, "abcdefghijklmnopqrstuvwxyz");
+
+  // Non-ASCII targets cannot be encoded in nibble tables and take the fallback path
+  const std::string high_targets = {static_cast<char>(0xC3), static_cast<char>(0xFF), '<'};
+  ExpectSameAsScalar(content, high_targets);
+}
+
+TEST_F(StringSimdTest, StructuralCarryAcrossBlocks) {
+  // "</" split over the 64-byte block boundary must still mark the '/'
+  std::string content(63, 'x');
+  content += "</p>";
+  content += std::string(100, '/');
+  ExpectSameAsScalar(content, "/");
+
+  const std::vector<std::uint32_t> positions = IndexWith(kScalarStringKernels, content);
+  const std::vector<std::uint32_t> expected = {63, 64, 66};
+  EXPECT_EQ(positions, expected);
+}
+
+TEST_F(StringSimdTest, CaseInsensitiveSearchMatchesScalar) {
+  // Close tags in mixed case between near misses, at offsets that straddle every block size
+  std::string content;
+  for (std::size_t i = 0; i < 40; ++i) {
+    content += std::string(i % 23, 'x');
+    content += (i % 3 == 0) ? "</scripx" : (i % 3 == 1) ? "</ScRiPt>" : "<\\/script";
+  }
+  ExpectSameAsScalar(content, "</script");
+  ExpectSameAsScalar(content, "</SCRIPT");
+
+  std::mt19937 rng(5);
+  for (std::size_t length = 0; length <= 150; length += 5) {
+    const std::string random = RandomString(&rng, length, "<>/sStT");
+    ExpectSameAsScalar(random, "</st");
+    ExpectSameAsScalar(random, "s");
+  }
+
+  EXPECT_EQ(FindIgnoreAsciiCase("let a = '</SCRIPT >';", 0, "</script"), 9U);
+  EXPECT_EQ(FindIgnoreAsciiCase("</style", 1, "</style"), std::string::npos);
+  EXPECT_EQ(FindIgnoreAsciiCase("anything", 0, ""), std::string::npos);
+}
+
+TEST_F(StringSimdTest, CollapseWhitespaceOfProse) {
+  // Mostly single spaces, so that most blocks take the copy path, with runs straddling block boundaries
+  std::mt19937 rng(7);
+  constexpr std::string_view kProseAlphabet = "abcdefghijklmnopqrstuvwxyz ";
+  for (std::size_t length = 0; length <= 300; length += 13) {
+    std::string content = RandomString(&rng, length, kProseAlphabet);
+    for (std::size_t i = 15; i < content.size(); i += 47) {
+      content[i] = '\n';
+    }
+    for (const auto& [name, kernels] : levels_) {
+      ASSERT_EQ(CollapseWith(*kernels, content), CollapseWith(kScalarStringKernels, content)) << name << " " << length;
+    }
+  }
+
+  const std::string text = "one two  three\tfour" + std::string(40, ' ') + "five ";
+  for (const auto& [name, kernels] : levels_) {
+    EXPECT_EQ(CollapseWith(*kernels, text), "one two three four five ") << name;
+  }
+}
+
+TEST_F(StringSimdTest, DispatchedFunctionsMatchScalar) {
+  std::mt19937 rng(99);
+  const std::string content = RandomString(&rng, 513, kMarkupAlphabet);
+  for (std::size_t begin = 0; begin < content.size(); begin += 7) {
+    EXPECT_EQ(SkipWhitespace(content, begin), scalar::SkipWhitespace(content, begin));
+    EXPECT_EQ(FindNextChar(content, begin, '>'), scalar::FindNextChar(content, begin, '>'));
+    EXPECT_EQ(FindNextAnyChar(content, begin, "=/"), scalar::FindNextAnyChar(content, begin, "=/"));
+  }
+}
+
+}  // namespace arboris
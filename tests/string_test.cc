@@ -69,6 +69,30 @@ TEST_F(StringUtilsTest, SkipWhitespaceBoundaryConditions) {
             std::numeric_limits<std::size_t>::max());
 }
 
+// AppendCollapsedWhitespace tests
+TEST_F(StringUtilsTest, AppendCollapsedWhitespaceJoinsWords) {
+  std::string out = "prefix:";
+  EXPECT_EQ(AppendCollapsedWhitespace(" \t hello \r\n\v world\f\ftest \n", &out), 16);
+  EXPECT_EQ(out, "prefix:hello world test");
+}
+
+TEST_F(StringUtilsTest, AppendCollapsedWhitespaceNothingToAppend) {
+  std::string out;
+  EXPECT_EQ(AppendCollapsedWhitespace(kEmptyString, &out), 0);
+  EXPECT_EQ(AppendCollapsedWhitespace(kWhitespaceString, &out), 0);
+  EXPECT_TRUE(out.empty());
+  EXPECT_EQ(AppendCollapsedWhitespace(kNoWhitespaceString, &out), kNoWhitespaceString.length());
+  EXPECT_EQ(out, kNoWhitespaceString);
+}
+
+TEST_F(StringUtilsTest, AppendCollapsedWhitespaceLongRuns) {
+  // Runs longer than a vector block on both sides of a word
+  const std::string text = std::string(100, ' ') + "a" + std::string(70, '\n') + "bc" + std::string(33, '\t');
+  std::string out;
+  EXPECT_EQ(AppendCollapsedWhitespace(text, &out), 4);
+  EXPECT_EQ(out, "a bc");
+}
+
 // ExtractSubstring tests
 TEST_F(StringUtilsTest, ExtractSubstringNormalCases) {
   EXPECT_EQ(ExtractSubstring(kHelloWorldString, 0, 5), kHelloString);
@@ -295,4 +319,21 @@ TEST_F(StringUtilsTest, MemorySafetyStringViewLifetime) {
   // This is something users need to be careful about, so we don't test it
 }
 
+TEST_F(StringUtilsTest, CompareIgnoreAsciiCase) {
+  EXPECT_EQ(ToLowerAscii('Q'), 'q');
+  EXPECT_EQ(ToLowerAscii('q'), 'q');
+  EXPECT_EQ(ToLowerAscii('@'), '@');
+  EXPECT_EQ(ToLowerAscii('['), '[');
+
+  EXPECT_EQ(CompareIgnoreAsciiCase("OG:Title", "og:title"), 0);
+  EXPECT_EQ(CompareIgnoreAsciiCase("", ""), 0);
+  EXPECT_LT(CompareIgnoreAsciiCase("Apple", "banana"), 0);
+  EXPECT_GT(CompareIgnoreAsciiCase("b", "APPLE"), 0);
+  EXPECT_LT(CompareIgnoreAsciiCase("og", "OG:"), 0);
+  EXPECT_GT(CompareIgnoreAsciiCase("og:", "OG"), 0);
+  // Bytes above ASCII compare as unsigned and are not folded
+  EXPECT_LT(CompareIgnoreAsciiCase("z", "\xC3\xA9"), 0);
+  EXPECT_NE(CompareIgnoreAsciiCase("\xC3\x89", "\xC3\xA9"), 0);
+}
+
 }  // namespace arboris
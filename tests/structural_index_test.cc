@@ -0,0 +1,78 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string/structural_index.hpp"
+
+namespace arboris {
+namespace {
+
+std::vector<std::uint32_t> Positions(const StructuralIndex& index) {
+  return {index.begin(), index.end()};
+}
+
+}  // anonymous namespace
+
+TEST(StructuralIndexTest, EmptyContent) {
+  StructuralIndex index;
+  index.Build("");
+  EXPECT_EQ(index.size(), 0);
+}
+
+TEST(StructuralIndexTest, TextWithoutMarkup) {
+  StructuralIndex index;
+  index.Build("plain text, no markup here / at all");
+  EXPECT_EQ(index.size(), 0);  // a '/' that does not follow '<' is not structural
+}
+
+TEST(StructuralIndexTest, TagsAndAttributes) {
+  // 0         1         2         3
+  // 0123456789012345678901234567890123
+  // <a href="x" id='y'>t</a><br/>
+  StructuralIndex index;
+  index.Build("<a href=\"x\" id='y'>t</a><br/>");
+
+  const std::vector<std::uint32_t> expected = {0, 7, 8, 10, 14, 15, 17, 18, 20, 21, 23, 24, 28};
+  EXPECT_EQ(Positions(index), expected);
+}
+
+TEST(StructuralIndexTest, RebuildReplacesPositions) {
+  StructuralIndex index;
+  index.Build(std::string(1000, '<'));
+  EXPECT_EQ(index.size(), 1000);
+
+  index.Build("a>b");
+  const std::vector<std::uint32_t> expected = {1};
+  EXPECT_EQ(Positions(index), expected);
+}
+
+TEST(StructuralIndexTest, ExtendMatchesBuildingAtOnce) {
+  const std::string content = "<p class=\"a\">x</p><br/><a href='y'>z</a>" + std::string(200, '<') + "</b>";
+  StructuralIndex whole;
+  whole.Build(content);
+
+  // Every split, including one between the '<' and '/' of a close tag
+  for (std::size_t split = 0; split <= content.length(); ++split) {
+    StructuralIndex index;
+    index.Build(std::string_view(content).substr(0, split));
+    index.Extend(content, split);
+    EXPECT_EQ(Positions(index), Positions(whole)) << "split at " << split;
+  }
+
+  // Growing one byte at a time
+  StructuralIndex grown;
+  for (std::size_t length = 1; length <= content.length(); ++length) {
+    grown.Extend(std::string_view(content).substr(0, length), length - 1);
+  }
+  EXPECT_EQ(Positions(grown), Positions(whole));
+}
+
+}  // namespace arboris
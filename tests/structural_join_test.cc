@@ -0,0 +1,69 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "query/structural_join.hpp"
+
+namespace arboris {
+namespace {
+
+// Nested lists with text between the items
+constexpr std::string_view kDocument =
+    "<ul id=outer><li>1</li><li>2<ul id=inner><li>2.1</li><li>2.2 <b>bold</b></li></ul></li></ul>"
+    "<p>between</p><ul id=last><li>3</li></ul><li>orphan</li>";
+
+std::vector<std::string_view> Texts(const std::vector<TagNode*>& nodes) {
+  std::vector<std::string_view> texts;
+  for (const TagNode* node : nodes) {
+    // The first child is the text of the item
+    texts.push_back(node->first_child()->text_content());
+  }
+  return texts;
+}
+
+}  // anonymous namespace
+
+TEST(StructuralJoinTest, Descendants) {
+  DOMManager manager(kDocument, {.zero_copy_text = true});
+  const DOMIndexer& indexer = manager.dom_indexer();
+  EXPECT_EQ(Texts(JoinDescendants(indexer.FindByTag(Tag::kUl), indexer.FindByTag(Tag::kLi))),
+            (std::vector<std::string_view>{"1", "2", "2.1", "2.2 ", "3"}));
+  // An li inside an li, past the end of the first nested one
+  EXPECT_EQ(Texts(JoinDescendants(indexer.FindByTag(Tag::kLi), indexer.FindByTag(Tag::kLi))),
+            (std::vector<std::string_view>{"2.1", "2.2 "}));
+  EXPECT_EQ(Texts(JoinDescendants(indexer.FindAllById("outer"), indexer.FindByTag(Tag::kB))),
+            (std::vector<std::string_view>{"bold"}));
+  EXPECT_TRUE(JoinDescendants(indexer.FindByTag(Tag::kP), indexer.FindByTag(Tag::kLi)).empty());
+  EXPECT_TRUE(JoinDescendants({}, indexer.FindByTag(Tag::kLi)).empty());
+}
+
+TEST(StructuralJoinTest, Children) {
+  DOMManager manager(kDocument, {.zero_copy_text = true});
+  const DOMIndexer& indexer = manager.dom_indexer();
+  EXPECT_EQ(Texts(JoinChildren(indexer.FindAllById("inner"), indexer.FindByTag(Tag::kLi))),
+            (std::vector<std::string_view>{"2.1", "2.2 "}));
+  EXPECT_EQ(Texts(JoinChildren(indexer.FindByTag(Tag::kUl), indexer.FindByTag(Tag::kLi))),
+            (std::vector<std::string_view>{"1", "2", "2.1", "2.2 ", "3"}));
+  // b is a grandchild of the inner list
+  EXPECT_TRUE(JoinChildren(indexer.FindByTag(Tag::kUl), indexer.FindByTag(Tag::kB)).empty());
+  EXPECT_EQ(Texts(JoinChildren(indexer.FindByTag(Tag::kLi), indexer.FindByTag(Tag::kB))),
+            (std::vector<std::string_view>{"bold"}));
+}
+
+TEST(StructuralJoinTest, UnclosedAncestorsExtendToTheEnd) {
+  DOMManager manager("<div><section><p>x</p></section><p>y</p>");
+  EXPECT_FALSE(manager.IsValid());
+  const DOMIndexer& indexer = manager.dom_indexer();
+  EXPECT_EQ(JoinDescendants(indexer.FindByTag(Tag::kDiv), indexer.FindByTag(Tag::kP)).size(), 2);
+  EXPECT_EQ(JoinChildren(indexer.FindByTag(Tag::kDiv), indexer.FindByTag(Tag::kP)).size(), 1);
+}
+
+}  // namespace arboris
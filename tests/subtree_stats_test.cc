@@ -0,0 +1,107 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string_view>
+
+#include "dom/dom_manager.hpp"
+#include "dom/subtree_stats.hpp"
+#include "dom/tree_index.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>Title</title><style>p {}</style></head><body>"
+    "<div id=nav><a href=/>Home</a> | <a href=/about><b>About</b> us</a></div>"
+    "<div id=content><p>Some longer text <a href=/x>link</a>.</p><script>var x;</script><p>More</p></div>"
+    "</body></html>";
+
+// Totals by visiting the subtree
+SubtreeTotals Traverse(const BaseNode& node, bool in_link = false) {
+  const TagNode* tag_node = node.As<TagNode>();
+  if (tag_node == nullptr) {
+    const auto bytes = static_cast<std::uint32_t>(node.text_content().size());
+    return {bytes, 0, 0, in_link ? bytes : 0};
+  }
+  if (tag_node->tag() == Tag::kScript || tag_node->tag() == Tag::kStyle) {
+    return {};
+  }
+  const bool is_link = tag_node->tag() == Tag::kA;
+  SubtreeTotals totals{0, 1, is_link ? 1U : 0U, 0};
+  for (const BaseNode* child : tag_node->children()) {
+    const SubtreeTotals child_totals = Traverse(*child, in_link || is_link);
+    totals.text_bytes += child_totals.text_bytes;
+    totals.elements += child_totals.elements;
+    totals.links += child_totals.links;
+    totals.link_text_bytes += child_totals.link_text_bytes;
+  }
+  return totals;
+}
+
+}  // anonymous namespace
+
+TEST(SubtreeStatsTest, MatchesTraversalForEveryNode) {
+  for (const std::string_view document : {kDocument, std::string_view("<div><a>x<a>y")}) {
+    DOMManager manager(document);
+    const SubtreeStats stats(*manager.root());
+    const TreeIndex tree(*manager.root());
+    for (const BaseNode* node : tree.nodes()) {
+      if (Closest(*node, Tag::kScript) != nullptr || Closest(*node, Tag::kStyle) != nullptr) {
+        continue;
+      }
+      const bool in_link = node->parent() != nullptr && Closest(*node->parent(), Tag::kA) != nullptr;
+      EXPECT_EQ(stats.Totals(*node), Traverse(*node, in_link)) << document << " node " << node->node_id();
+    }
+  }
+}
+
+TEST(SubtreeStatsTest, FlatDocumentGivesTheSameTotals) {
+  DOMManager manager(kDocument, {.build_flat_document = true});
+  const SubtreeStats linked(*manager.root());
+  const SubtreeStats flat(*manager.flat_document());
+  const FlatDocument& document = *manager.flat_document();
+  for (std::uint32_t id = 0; id < document.size(); ++id) {
+    EXPECT_EQ(flat.Totals(document.in(id), document.out(id)), linked.Totals(document.in(id), document.out(id)))
+        << "node " << id;
+  }
+}
+
+TEST(SubtreeStatsTest, LinkDensity) {
+  DOMManager manager(kDocument);
+  const SubtreeStats stats(*manager.root());
+  const DOMIndexer& indexer = manager.dom_indexer();
+
+  const SubtreeTotals nav = stats.Totals(*indexer.FindById("nav"));
+  EXPECT_EQ(nav.text_bytes, 15);
+  EXPECT_EQ(nav.link_text_bytes, 12);
+  EXPECT_EQ(nav.links, 2);
+  EXPECT_EQ(nav.elements, 4);
+
+  const SubtreeTotals content = stats.Totals(*indexer.FindById("content"));
+  EXPECT_EQ(content.text_bytes, 26);
+  EXPECT_EQ(content.link_text_bytes, 4);
+  EXPECT_LT(content.link_density(), nav.link_density());
+  EXPECT_EQ(SubtreeTotals{}.link_density(), 0.0);
+
+  // Excluded elements count nothing
+  EXPECT_EQ(stats.Totals(*indexer.FindByTag(Tag::kScript).front()), SubtreeTotals{});
+}
+
+TEST(SubtreeStatsTest, SubtreeRootAndExcludedTags) {
+  DOMManager manager(kDocument);
+  const TagNode* content = manager.dom_indexer().FindById("content");
+  // Replaces the default exclusions, so the script text counts
+  const SubtreeStats stats(*content, {.excluded_tags = {Tag::kA}});
+  const SubtreeTotals totals = stats.Totals(*content);
+  EXPECT_EQ(totals.text_bytes, 28);
+  EXPECT_EQ(totals.links, 0);
+  EXPECT_EQ(totals.elements, 4);
+  EXPECT_EQ(stats.Totals(*content->last_child()).text_bytes, 4);
+}
+
+}  // namespace arboris
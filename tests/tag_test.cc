@@ -0,0 +1,69 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cctype>
+#include <cstddef>
+#include <string>
+
+#include "utils/tag.hpp"
+
+namespace arboris {
+
+TEST(TagTest, EveryTagRoundTrips) {
+  for (std::size_t i = 1; i < kTagCount; ++i) {
+    const auto tag = static_cast<Tag>(i);
+    const std::string_view name = ToString(tag);
+    ASSERT_FALSE(name.empty()) << "tag #" << i;
+    EXPECT_EQ(FromString(name), tag) << name;
+  }
+  EXPECT_TRUE(ToString(Tag::kUnknown).empty());
+}
+
+TEST(TagTest, LookupIgnoresAsciiCase) {
+  EXPECT_EQ(FromString("DIV"), Tag::kDiv);
+  EXPECT_EQ(FromString("Meta"), Tag::kMeta);
+  EXPECT_EQ(FromString("H1"), Tag::kH1);
+  EXPECT_EQ(FromString("bLoCkQuOtE"), Tag::kBlockquote);
+
+  for (std::size_t i = 1; i < kTagCount; ++i) {
+    std::string upper(ToString(static_cast<Tag>(i)));
+    for (char& c : upper) {
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    EXPECT_EQ(FromString(upper), static_cast<Tag>(i)) << upper;
+  }
+}
+
+TEST(TagTest, UnknownNames) {
+  EXPECT_EQ(FromString(""), Tag::kUnknown);
+  EXPECT_EQ(FromString("di"), Tag::kUnknown);
+  EXPECT_EQ(FromString("divx"), Tag::kUnknown);
+  EXPECT_EQ(FromString("h7"), Tag::kUnknown);
+  EXPECT_EQ(FromString("custom-element"), Tag::kUnknown);
+  EXPECT_EQ(FromString("!DOCTYPE"), Tag::kUnknown);
+  EXPECT_EQ(FromString("d\xC9v"), Tag::kUnknown);  // only ASCII letters fold
+  EXPECT_EQ(FromString("blockquotes"), Tag::kUnknown);
+}
+
+TEST(TagTest, VoidTags) {
+  EXPECT_TRUE(IsVoidTag(Tag::kBr));
+  EXPECT_TRUE(IsVoidTag(Tag::kImg));
+  EXPECT_FALSE(IsVoidTag(Tag::kDiv));
+  EXPECT_FALSE(IsVoidTag(Tag::kUnknown));
+}
+
+TEST(TagTest, BlockTags) {
+  EXPECT_TRUE(IsBlockTag(Tag::kP));
+  EXPECT_TRUE(IsBlockTag(Tag::kDiv));
+  EXPECT_TRUE(IsBlockTag(Tag::kBr));
+  EXPECT_TRUE(IsBlockTag(Tag::kLi));
+  EXPECT_FALSE(IsBlockTag(Tag::kA));
+  EXPECT_FALSE(IsBlockTag(Tag::kSpan));
+  EXPECT_FALSE(IsBlockTag(Tag::kUnknown));
+}
+
+}  // namespace arboris
@@ -0,0 +1,82 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "dom/dom_indexer.hpp"
+#include "dom/dom_manager.hpp"
+#include "dom/text_extractor.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>Title</title><style>p { color: red }</style></head>"
+    "<body>\n  <div id=main><p>First   paragraph\twith <b>bold</b>text.</p>"
+    "<script>var x = '<p>';</script>"
+    "<ul><li>one</li><li> two </li></ul>Tail<br>line</div>\n</body></html>";
+
+std::string Extract(const DOMManager& manager, const TextExtractionOptions& options = {}) {
+  std::string text;
+  const std::size_t written = manager.ExtractText(*manager.root(), options, &text);
+  EXPECT_EQ(written, text.size());
+  return text;
+}
+
+}  // anonymous namespace
+
+TEST(TextExtractorTest, CollapsesWhitespaceAndSkipsScriptAndStyle) {
+  DOMManager manager(kDocument);
+  ASSERT_TRUE(manager.IsValid());
+  EXPECT_EQ(Extract(manager), "Title First paragraph with boldtext.one two Tailline");
+}
+
+TEST(TextExtractorTest, BlockSeparators) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Extract(manager, {.block_separators = true}),
+            "Title\nFirst paragraph with boldtext.\none\ntwo\nTail\nline");
+}
+
+TEST(TextExtractorTest, KeepsWhitespaceWhenNotCollapsing) {
+  DOMManager manager("<div> a  <span>b</span>\n</div><p>c</p><p>\nd</p>");
+  EXPECT_EQ(Extract(manager, {.collapse_whitespace = false}), " a  b\nc\nd");
+  EXPECT_EQ(Extract(manager, {.collapse_whitespace = false, .block_separators = true}), " a  b\nc\n\nd");
+}
+
+TEST(TextExtractorTest, ExcludedTags) {
+  DOMManager manager(kDocument);
+  EXPECT_EQ(Extract(manager, {.excluded_tags = {Tag::kHead, Tag::kLi, Tag::kScript}}),
+            "First paragraph with boldtext.Tailline");
+  EXPECT_EQ(Extract(manager, {.excluded_tags = {}}),
+            "Titlep { color: red } First paragraph with boldtext.var x = '<p>';one two Tailline");
+}
+
+TEST(TextExtractorTest, SubtreeAndAppend) {
+  DOMManager manager(kDocument);
+  const TagNode* ul = manager.dom_indexer().FindByTag(Tag::kUl).front();
+  std::string text = "prefix:";
+  EXPECT_EQ(manager.ExtractText(*ul, {.block_separators = true}, &text), 7);
+  EXPECT_EQ(text, "prefix:one\ntwo");
+
+  // The subtree itself is never excluded
+  const TagNode* script = manager.dom_indexer().FindByTag(Tag::kScript).front();
+  text.clear();
+  EXPECT_EQ(ExtractText(*script, {}, &text), 14);
+  EXPECT_EQ(text, "var x = '<p>';");
+
+  const TagNode* empty = manager.dom_indexer().FindByTag(Tag::kBr).front();
+  EXPECT_EQ(ExtractText(*empty, {}, &text), 0);
+}
+
+TEST(TextExtractorTest, NothingButWhitespace) {
+  DOMManager manager("<div>  <p> \n </p>\t</div>");
+  EXPECT_EQ(Extract(manager), "");
+  EXPECT_EQ(Extract(manager, {.block_separators = true}), "");
+}
+
+}  // namespace arboris
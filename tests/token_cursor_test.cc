@@ -0,0 +1,150 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "dom/token_cursor.hpp"
+#include "utils/string_pool.hpp"
+
+namespace arboris {
+
+static_assert(std::ranges::input_range<TokenCursor>);
+
+namespace {
+
+constexpr std::string_view kPage =
+    "<!DOCTYPE html><html><head><title>T</title><script>a<b</script></head>"
+    "<body><div id=nav><ul><li>1</li><li>2<br></li></ul></div><p>Hi</p></body></html>";
+
+// One letter per token kind followed by the tag or text, e.g. "<p", "t:Hi", "/p"
+std::string Describe(const TokenCursor::Token& token) {
+  if (const auto* open_token = std::get_if<HtmlToken>(&token)) {
+    return "<" + std::string(ToString(open_token->tag));
+  }
+  if (const auto* text_token = std::get_if<HtmlTextToken>(&token)) {
+    return "t:" + std::string(text_token->text_content);
+  }
+  return "/" + std::string(ToString(std::get<HtmlCloseToken>(token).tag));
+}
+
+}  // anonymous namespace
+
+TEST(TokenCursorTest, NextReturnsTokensInOrder) {
+  TokenCursor cursor("<p class=x>Hello <b>World</b></p>");
+  std::vector<std::string> tokens;
+  while (std::optional<TokenCursor::Token> token = cursor.Next()) {
+    tokens.push_back(Describe(*token));
+  }
+
+  const std::vector<std::string> expected = {"<p", "t:Hello ", "<b", "t:World", "/b", "/p"};
+  EXPECT_EQ(tokens, expected);
+  EXPECT_FALSE(cursor.failed());
+  EXPECT_FALSE(cursor.Next().has_value());
+}
+
+TEST(TokenCursorTest, StopsEarly) {
+  TokenCursor cursor(kPage);
+  std::vector<std::string> tokens;
+  for (const TokenCursor::Token& token : cursor) {
+    tokens.push_back(Describe(token));
+    if (const auto* close_token = std::get_if<HtmlCloseToken>(&token); close_token && close_token->tag == Tag::kHead) {
+      break;
+    }
+  }
+
+  // The doctype is skipped and the script is a single text token
+  const std::vector<std::string> expected = {"<html", "<head", "<title", "t:T", "/title", "<script", "t:a<b", "/script",
+                                             "/head"};
+  EXPECT_EQ(tokens, expected);
+  EXPECT_EQ(kPage.substr(cursor.consumed()).substr(0, 6), "<body>");
+}
+
+TEST(TokenCursorTest, SkipSubtree) {
+  TokenCursor cursor(kPage);
+  std::vector<std::string> tokens;
+  while (std::optional<TokenCursor::Token> token = cursor.Next()) {
+    tokens.push_back(Describe(*token));
+    const auto* open_token = std::get_if<HtmlToken>(&*token);
+    if (open_token && (open_token->tag == Tag::kHead || open_token->id == "nav")) {
+      ASSERT_TRUE(cursor.SkipSubtree());
+    }
+  }
+
+  const std::vector<std::string> expected = {"<html", "<head", "<body", "<div", "<p", "t:Hi", "/p", "/body", "/html"};
+  EXPECT_EQ(tokens, expected);
+}
+
+TEST(TokenCursorTest, SkipSubtreeDependsOnTheLastToken) {
+  // A void element has nothing to skip
+  TokenCursor cursor("<div><img><p>x</p></div>");
+  ASSERT_TRUE(cursor.Next().has_value());
+  const auto image = cursor.Next();
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(Describe(*image), "<img");
+  EXPECT_TRUE(cursor.SkipSubtree());
+  const auto paragraph = cursor.Next();
+  ASSERT_TRUE(paragraph.has_value());
+  EXPECT_EQ(Describe(*paragraph), "<p");
+
+  // Text and close tokens leave no element to skip, and nothing is consumed
+  const auto text = cursor.Next();
+  ASSERT_TRUE(text.has_value());
+  EXPECT_EQ(Describe(*text), "t:x");
+  EXPECT_FALSE(cursor.SkipSubtree());
+  const auto close = cursor.Next();
+  ASSERT_TRUE(close.has_value());
+  EXPECT_EQ(Describe(*close), "/p");
+  EXPECT_FALSE(cursor.SkipSubtree());
+  const auto outer_close = cursor.Next();
+  ASSERT_TRUE(outer_close.has_value());
+  EXPECT_EQ(Describe(*outer_close), "/div");
+
+  // Nor does a fresh cursor, or one that skipped already
+  TokenCursor fresh("<p>x</p>");
+  EXPECT_FALSE(fresh.SkipSubtree());
+  ASSERT_TRUE(fresh.Next().has_value());
+  EXPECT_TRUE(fresh.SkipSubtree());
+  EXPECT_FALSE(fresh.SkipSubtree());
+}
+
+TEST(TokenCursorTest, TextWithAndWithoutPool) {
+  constexpr std::string_view kHtml = "<p>text</p>";
+
+  TokenCursor views(kHtml);
+  ASSERT_TRUE(views.Next().has_value());
+  const auto text = views.Next();
+  ASSERT_TRUE(text.has_value());
+  EXPECT_EQ(std::get<HtmlTextToken>(*text).text_content.data(), kHtml.data() + 3);
+
+  auto string_pool = std::make_shared<StringPool>(64);
+  TokenCursor pooled(kHtml, string_pool);
+  ASSERT_TRUE(pooled.Next().has_value());
+  const auto pooled_text = pooled.Next();
+  ASSERT_TRUE(pooled_text.has_value());
+  EXPECT_EQ(std::get<HtmlTextToken>(*pooled_text).text_content, "text");
+  EXPECT_NE(std::get<HtmlTextToken>(*pooled_text).text_content.data(), kHtml.data() + 3);
+}
+
+TEST(TokenCursorTest, MalformedInput) {
+  TokenCursor cursor("<p>ok</p><div id='open>");
+  EXPECT_FALSE(cursor.Parse());
+  EXPECT_TRUE(cursor.failed());
+  EXPECT_FALSE(cursor.Next().has_value());
+
+  TokenCursor truncated("<div><p>text");
+  EXPECT_TRUE(truncated.Next().has_value());
+  EXPECT_FALSE(truncated.SkipSubtree());
+  EXPECT_FALSE(truncated.failed());
+}
+
+}  // namespace arboris
@@ -0,0 +1,114 @@
+/*
+ *   Copyright 2025 Team Arboris
+ *   Licensed under the Apache License, Version 2.0
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "dom/dom_manager.hpp"
+#include "dom/tree_index.hpp"
+
+namespace arboris {
+namespace {
+
+constexpr std::string_view kDocument =
+    "<html><head><title>T</title></head><body>"
+    "<div id=a><p>one<b>two</b></p><div id=b><span>three</span>four</div></div>"
+    "<ul><li>x</li><li><a href=/>y</a></li></ul>tail</body></html>";
+
+// Ancestors of a node from its parent up to the document root
+std::vector<const TagNode*> Ancestors(const BaseNode& node) {
+  std::vector<const TagNode*> ancestors;
+  for (const TagNode* parent = node.parent(); parent != nullptr; parent = parent->parent()) {
+    ancestors.push_back(parent);
+  }
+  return ancestors;
+}
+
+const TagNode* NaiveLowestCommonAncestor(const BaseNode& lhs, const BaseNode& rhs) {
+  std::vector<const TagNode*> lhs_chain = Ancestors(lhs);
+  if (const TagNode* element = lhs.As<TagNode>()) {
+    lhs_chain.insert(lhs_chain.begin(), element);
+  }
+  for (const TagNode* element : lhs_chain) {
+    if (element == &rhs || IsAncestor(*element, rhs)) {
+      return element;
+    }
+  }
+  return nullptr;
+}
+
+}  // anonymous namespace
+
+TEST(TreeIndexTest, IsAncestorMatchesParentChains) {
+  DOMManager manager(kDocument);
+  ASSERT_TRUE(manager.IsValid());
+  const TreeIndex tree(*manager.root());
+  ASSERT_EQ(tree.size(), 22);
+
+  for (const BaseNode* node : tree.nodes()) {
+    const std::vector<const TagNode*> ancestors = Ancestors(*node);
+    EXPECT_EQ(tree.Depth(*node), ancestors.size());
+    for (const BaseNode* other : tree.nodes()) {
+      const bool expected = std::find(ancestors.begin(), ancestors.end(), other) != ancestors.end();
+      EXPECT_EQ(IsAncestor(*other, *node), expected) << other->node_id() << " " << node->node_id();
+    }
+  }
+}
+
+TEST(TreeIndexTest, LowestCommonAncestorOfEveryPair) {
+  DOMManager manager(kDocument);
+  const TreeIndex tree(*manager.root());
+  for (const BaseNode* lhs : tree.nodes()) {
+    for (const BaseNode* rhs : tree.nodes()) {
+      EXPECT_EQ(tree.LowestCommonAncestor(*lhs, *rhs), NaiveLowestCommonAncestor(*lhs, *rhs))
+          << lhs->node_id() << " " << rhs->node_id();
+    }
+  }
+
+  const DOMIndexer& indexer = manager.dom_indexer();
+  const TagNode* span = indexer.FindByTag(Tag::kSpan).front();
+  const TagNode* b = indexer.FindByTag(Tag::kB).front();
+  EXPECT_EQ(tree.LowestCommonAncestor(*span, *b), indexer.FindById("a"));
+  EXPECT_EQ(tree.LowestCommonAncestor(*span, *indexer.FindByTag(Tag::kA).front()),
+            indexer.FindByTag(Tag::kBody).front());
+}
+
+TEST(TreeIndexTest, SubtreeIndex) {
+  DOMManager manager(kDocument);
+  const TagNode* ul = manager.dom_indexer().FindByTag(Tag::kUl).front();
+  const TreeIndex tree(*ul);
+  EXPECT_EQ(tree.size(), 6);
+  EXPECT_EQ(&tree.root(), ul);
+  const TagNode* a = manager.dom_indexer().FindByTag(Tag::kA).front();
+  EXPECT_EQ(tree.Depth(*a), 2);
+  EXPECT_EQ(tree.LowestCommonAncestor(*a, *ul->first_child()), ul);
+}
+
+TEST(TreeIndexTest, Closest) {
+  DOMManager manager(kDocument);
+  const DOMIndexer& indexer = manager.dom_indexer();
+  const TagNode* span = indexer.FindByTag(Tag::kSpan).front();
+  EXPECT_EQ(Closest(*span, Tag::kDiv), indexer.FindById("b"));
+  EXPECT_EQ(Closest(*span, Tag::kSpan), span);
+  EXPECT_EQ(Closest(*span->first_child(), Tag::kSpan), span);
+  EXPECT_EQ(Closest(*span, Tag::kBody), indexer.FindByTag(Tag::kBody).front());
+  EXPECT_EQ(Closest(*span, Tag::kUl), nullptr);
+}
+
+TEST(TreeIndexTest, UnclosedTagsExtendToTheEnd) {
+  DOMManager manager("<div><p>text");
+  const TagNode* div = manager.dom_indexer().FindByTag(Tag::kDiv).front();
+  const TagNode* p = manager.dom_indexer().FindByTag(Tag::kP).front();
+  EXPECT_TRUE(IsAncestor(*div, *p));
+  EXPECT_TRUE(IsAncestor(*div, *p->first_child()));
+  EXPECT_FALSE(IsAncestor(*p, *div));
+  EXPECT_TRUE(IsAncestor(*manager.root(), *div));
+}
+
+}  // namespace arboris